@@ -0,0 +1,524 @@
+/*
+* /File: BigFloat.cpp /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+
+#include "BigFloat.h"
+#include "BigInt.h"
+#include "BigReal.h"
+
+
+namespace lez
+{
+
+BigFloat::BigFloat() :
+	b_mant(), // zero
+	b_exp(0),
+	b_prec(start_precision())
+{
+}
+
+BigFloat::BigFloat(const BigFloat& val_) :
+	b_mant(val_.b_mant),
+	b_exp(val_.b_exp),
+	b_prec(val_.b_prec)
+{
+}
+
+BigFloat::BigFloat(BigFloat&& val_) :
+	b_mant(std::move(val_.b_mant)),
+	b_exp(val_.b_exp),
+	b_prec(val_.b_prec)
+{
+}
+
+BigFloat::BigFloat(std::int32_t val_) :
+	BigFloat()
+{
+	*this = to_big_float(BigInt::to_big_int(val_), start_precision(), start_rounding_mode());
+}
+
+BigFloat::BigFloat(std::int64_t val_) :
+	BigFloat()
+{
+	*this = to_big_float(BigInt::to_big_int(val_), start_precision(), start_rounding_mode());
+}
+
+BigFloat::BigFloat(const BigInt& val_) :
+	BigFloat()
+{
+	*this = to_big_float(val_, start_precision(), start_rounding_mode());
+}
+
+BigFloat::BigFloat(double val_) :
+	BigFloat()
+{
+	*this = to_big_float(val_, start_precision(), start_rounding_mode());
+}
+
+BigFloat::BigFloat(const BigReal& val_) :
+	BigFloat()
+{
+	*this = to_big_float(val_, start_precision(), start_rounding_mode());
+}
+
+
+// ----------------------------------------------------------------------------
+// assignment operator
+BigFloat& BigFloat::operator=(std::int32_t val_)
+{
+	*this = BigFloat(val_);
+	return *this;
+}
+
+BigFloat& BigFloat::operator=(std::int64_t val_)
+{
+	*this = BigFloat(val_);
+	return *this;
+}
+
+BigFloat& BigFloat::operator=(const BigInt& val_)
+{
+	*this = BigFloat(val_);
+	return *this;
+}
+
+BigFloat& BigFloat::operator=(double val_)
+{
+	*this = BigFloat(val_);
+	return *this;
+}
+
+BigFloat& BigFloat::operator=(const BigReal& val_)
+{
+	*this = BigFloat(val_);
+	return *this;
+}
+
+BigFloat& BigFloat::operator=(BigFloat val_)
+{
+	BigFloat::swap(*this, val_);
+	return *this;
+}
+
+
+// ----------------------------------------------------------------------------
+// to type
+BigInt BigFloat::to_big_int() const
+{
+	if (b_exp >= 0)
+		return b_mant << static_cast<std::size_t>(b_exp);
+	BigInt mag = b_mant;
+	mag.reset_neg();
+	mag >>= static_cast<std::size_t>(-(b_exp + 1)) + 1U;
+	if (b_mant.is_neg())
+		mag.set_neg();
+	return mag;
+}
+
+BigReal BigFloat::to_big_real() const
+{
+	if (b_exp >= 0)
+		return BigReal::to_big_real(b_mant << static_cast<std::size_t>(b_exp), 0);
+	std::size_t am_frac = static_cast<std::size_t>(-(b_exp + 1)) + 1U;
+	return BigReal::to_big_real(b_mant * BigReal::power(5U, am_frac), b_exp);
+}
+
+double BigFloat::to_double() const
+{
+	// rounded once at the last bit the double keeps: 53 bits, fewer below 2^-1022
+	if (is_zero())
+		return 0.0;
+	double sign = is_neg() ? -1.0 : 1.0;
+	std::int64_t lead_exp = top() - 1; // 2^lead_exp <= |val|
+	const std::int64_t min_exp = std::numeric_limits<double>::min_exponent - std::numeric_limits<double>::digits; // -1074
+	if (lead_exp >= std::numeric_limits<double>::max_exponent)
+		return sign * std::numeric_limits<double>::infinity();
+	if (lead_exp < min_exp - 1)
+		return sign * 0.0;
+	if (lead_exp == min_exp - 1) // half of the least subnormal or more: a tie only if exactly half
+		return sign * (b_mant.bit_length() == 1U ? 0.0 : std::ldexp(1.0, static_cast<int>(min_exp)));
+	std::size_t am_keep = static_cast<std::size_t>(std::min<std::int64_t>(std::numeric_limits<double>::digits,
+		lead_exp - min_exp + 1));
+	BigFloat res = rounded(b_mant, b_exp, false, am_keep, RoundingMode::nearest_even);
+	if (res.top() > std::numeric_limits<double>::max_exponent)
+		return sign * std::numeric_limits<double>::infinity(); // carried out of the range
+	return std::ldexp(static_cast<double>(res.b_mant.to_int64()), static_cast<int>(res.b_exp));
+}
+
+
+// ----------------------------------------------------------------------------
+// extra
+const BigInt& BigFloat::mantissa() const
+{
+	return b_mant;
+}
+
+std::int64_t BigFloat::exponent() const
+{
+	return b_exp;
+}
+
+std::size_t BigFloat::get_precision() const
+{
+	return b_prec;
+}
+
+void BigFloat::set_precision(std::size_t prec_)
+{
+	set_precision(prec_, start_rounding_mode());
+}
+
+void BigFloat::set_precision(std::size_t prec_, RoundingMode mode_)
+{
+	*this = rounded(std::move(b_mant), b_exp, false, prec_, mode_);
+}
+
+bool BigFloat::is_neg() const
+{
+	return b_mant.is_neg();
+}
+
+bool BigFloat::is_zero() const
+{
+	return b_mant.is_zero();
+}
+
+void BigFloat::reverse_neg()
+{
+	b_mant.reverse_neg();
+}
+
+void BigFloat::reset()
+{
+	*this = BigFloat();
+}
+
+std::int64_t BigFloat::top() const
+{
+	return b_exp + static_cast<std::int64_t>(b_mant.bit_length());
+}
+
+
+// ----------------------------------------------------------------------------
+// operators
+BigFloat::operator bool() const
+{
+	return !is_zero();
+}
+
+BigFloat::operator BigInt() const
+{
+	return to_big_int();
+}
+
+BigFloat::operator double() const
+{
+	return to_double();
+}
+
+const BigFloat BigFloat::operator-() const
+{
+	BigFloat bf(*this);
+	bf.b_mant.reverse_neg();
+	return bf;
+}
+
+const BigFloat BigFloat::operator+() const
+{
+	return *this; // cp
+}
+
+
+// ----------------------------------------------------------------------------
+// arithmetic
+const BigFloat BigFloat::operator+(const BigFloat& r_val_) const
+{
+	return add(*this, r_val_, std::max(b_prec, r_val_.b_prec), start_rounding_mode());
+}
+
+const BigFloat BigFloat::operator-(const BigFloat& r_val_) const
+{
+	return subtract(*this, r_val_, std::max(b_prec, r_val_.b_prec), start_rounding_mode());
+}
+
+const BigFloat BigFloat::operator*(const BigFloat& r_val_) const
+{
+	return multiply(*this, r_val_, std::max(b_prec, r_val_.b_prec), start_rounding_mode());
+}
+
+const BigFloat BigFloat::operator/(const BigFloat& r_val_) const
+{
+	return divide(*this, r_val_, std::max(b_prec, r_val_.b_prec), start_rounding_mode());
+}
+
+BigFloat& BigFloat::operator+=(const BigFloat& r_val_)
+{
+	*this = this->operator+(r_val_);
+	return *this;
+}
+
+BigFloat& BigFloat::operator-=(const BigFloat& r_val_)
+{
+	*this = this->operator-(r_val_);
+	return *this;
+}
+
+BigFloat& BigFloat::operator*=(const BigFloat& r_val_)
+{
+	*this = this->operator*(r_val_);
+	return *this;
+}
+
+BigFloat& BigFloat::operator/=(const BigFloat& r_val_)
+{
+	*this = this->operator/(r_val_);
+	return *this;
+}
+
+BigFloat BigFloat::add(const BigFloat& l_val_, const BigFloat& r_val_, std::size_t prec_, RoundingMode mode_)
+{
+	if (l_val_.is_zero() || r_val_.is_zero())
+	{
+		const BigFloat& val = l_val_.is_zero() ? r_val_ : l_val_;
+		return rounded(val.b_mant, val.b_exp, false, prec_, mode_);
+	}
+	const BigFloat& big = (l_val_.top() >= r_val_.top()) ? l_val_ : r_val_;
+	const BigFloat& small = (l_val_.top() >= r_val_.top()) ? r_val_ : l_val_;
+	// rounding points and midpoints near big are multiples of 2^low, so does big; a small operand
+	// below 2^low only tells on which side of big the sum lies, any value of its sign there will do
+	std::int64_t low = std::min(big.b_exp, big.top() - static_cast<std::int64_t>(std::max<std::size_t>(prec_, 1U))) - 2;
+	BigInt small_mant = small.b_mant;
+	std::int64_t small_exp = small.b_exp;
+	if (small.top() <= low)
+	{
+		small_mant = BigInt::to_big_int(small.is_neg() ? -1 : 1);
+		small_exp = low - 1;
+	}
+	std::int64_t exp = std::min(big.b_exp, small_exp);
+	BigInt sum = (big.b_mant << static_cast<std::size_t>(big.b_exp - exp))
+		+ (small_mant << static_cast<std::size_t>(small_exp - exp));
+	return rounded(std::move(sum), exp, false, prec_, mode_);
+}
+
+BigFloat BigFloat::subtract(const BigFloat& l_val_, const BigFloat& r_val_, std::size_t prec_, RoundingMode mode_)
+{
+	return add(l_val_, -r_val_, prec_, mode_);
+}
+
+BigFloat BigFloat::multiply(const BigFloat& l_val_, const BigFloat& r_val_, std::size_t prec_, RoundingMode mode_)
+{
+	return rounded(l_val_.b_mant * r_val_.b_mant, l_val_.b_exp + r_val_.b_exp, false, prec_, mode_);
+}
+
+BigFloat BigFloat::divide(const BigFloat& l_val_, const BigFloat& r_val_, std::size_t prec_, RoundingMode mode_)
+{
+	if (l_val_.is_zero() || r_val_.is_zero())
+		return rounded(BigInt(), 0, false, prec_, mode_); // division by zero is zero
+	return quotient(l_val_.b_mant, r_val_.b_mant, l_val_.b_exp - r_val_.b_exp,
+		l_val_.is_neg() != r_val_.is_neg(), prec_, mode_);
+}
+
+BigFloat BigFloat::rounded(BigInt mant_, std::int64_t exp_, bool is_sticky_, std::size_t prec_, RoundingMode mode_)
+{
+	BigFloat res;
+	res.b_prec = std::max<std::size_t>(prec_, 1U);
+	if (mant_.is_zero())
+		return res;
+	bool is_neg = mant_.is_neg();
+	mant_.reset_neg();
+	std::size_t len = mant_.bit_length();
+	if (is_sticky_ && len < res.b_prec + 2U) // a rounding bit of its own, the sticky part stays below
+	{
+		std::size_t shift = res.b_prec + 2U - len;
+		mant_ <<= shift;
+		exp_ -= static_cast<std::int64_t>(shift);
+		len += shift;
+	}
+	if (len > res.b_prec)
+	{
+		std::size_t am_drop = len - res.b_prec;
+		bool is_half = mant_.test_bit(am_drop - 1U);
+		bool is_rest = is_sticky_ || mant_.count_trailing_zeros() < am_drop - 1U;
+		mant_ >>= am_drop;
+		exp_ += static_cast<std::int64_t>(am_drop);
+		bool is_away = false; // from zero
+		switch (mode_)
+		{
+		case RoundingMode::nearest_even:
+			is_away = is_half && (is_rest || mant_.is_odd());
+			break;
+		case RoundingMode::toward_zero:
+			break;
+		case RoundingMode::up:
+			is_away = !is_neg && (is_half || is_rest);
+			break;
+		case RoundingMode::down:
+			is_away = is_neg && (is_half || is_rest);
+			break;
+		}
+		if (is_away)
+			mant_ += 1; // 2^prec at most, the trailing zeros go below
+	}
+	std::size_t am_zeros = mant_.count_trailing_zeros();
+	mant_ >>= am_zeros;
+	exp_ += static_cast<std::int64_t>(am_zeros);
+	if (is_neg)
+		mant_.set_neg();
+	res.b_mant = std::move(mant_);
+	res.b_exp = exp_;
+	return res;
+}
+
+BigFloat BigFloat::quotient(const BigInt& num_, const BigInt& den_, std::int64_t exp_, bool is_neg_,
+	std::size_t prec_, RoundingMode mode_)
+{
+	// prec_ + 2 bits of the quotient at least, the remainder is sticky
+	BigInt num = num_;
+	BigInt den = den_;
+	num.reset_neg();
+	den.reset_neg();
+	std::size_t len = std::max<std::size_t>(prec_, 1U) + 2U + den.bit_length();
+	std::size_t shift = (len > num.bit_length()) ? len - num.bit_length() : 0U;
+	num <<= shift;
+	BigInt quot = num / den;
+	bool is_sticky = !(num - quot * den).is_zero();
+	if (is_neg_)
+		quot.set_neg();
+	return rounded(std::move(quot), exp_ - static_cast<std::int64_t>(shift), is_sticky, prec_, mode_);
+}
+
+
+// ----------------------------------------------------------------------------
+// compare
+bool BigFloat::operator>(const BigFloat& r_val_) const
+{
+	return compare(*this, r_val_) > 0;
+}
+
+bool BigFloat::operator<(const BigFloat& r_val_) const
+{
+	return compare(*this, r_val_) < 0;
+}
+
+bool BigFloat::operator>=(const BigFloat& r_val_) const
+{
+	return compare(*this, r_val_) >= 0;
+}
+
+bool BigFloat::operator<=(const BigFloat& r_val_) const
+{
+	return compare(*this, r_val_) <= 0;
+}
+
+bool BigFloat::operator==(const BigFloat& r_val_) const
+{
+	return b_exp == r_val_.b_exp && b_mant == r_val_.b_mant; // odd mantissas
+}
+
+bool BigFloat::operator!=(const BigFloat& r_val_) const
+{
+	return !operator==(r_val_);
+}
+
+int BigFloat::compare(const BigFloat& l_val_, const BigFloat& r_val_)
+{
+	int sign_l = l_val_.is_zero() ? 0 : (l_val_.is_neg() ? -1 : 1);
+	int sign_r = r_val_.is_zero() ? 0 : (r_val_.is_neg() ? -1 : 1);
+	if (sign_l != sign_r)
+		return sign_l < sign_r ? -1 : 1;
+	if (sign_l == 0)
+		return 0;
+	if (l_val_.top() != r_val_.top())
+		return (l_val_.top() < r_val_.top()) ? -sign_l : sign_l;
+	std::int64_t exp = std::min(l_val_.b_exp, r_val_.b_exp);
+	BigInt l_mant = l_val_.b_mant << static_cast<std::size_t>(l_val_.b_exp - exp);
+	BigInt r_mant = r_val_.b_mant << static_cast<std::size_t>(r_val_.b_exp - exp);
+	return l_mant < r_mant ? -1 : (l_mant == r_mant ? 0 : 1);
+}
+
+
+// ----------------------------------------------------------------------------
+// stream
+std::ostream& BigFloat::operator<<(std::ostream& stream_) const
+{
+	return stream_ << to_string();
+}
+
+std::string BigFloat::to_string() const
+{
+	// log10(2) = 0.30103
+	return to_big_real().to_string_scientific(b_prec * 30103U / 100000U + 2U);
+}
+
+std::ostream& operator<<(std::ostream& stream_, const BigFloat& bf_)
+{
+	return bf_.operator<<(stream_);
+}
+
+
+// ----------------------------------------------------------------------------
+// to big float
+BigFloat BigFloat::to_big_float(const BigInt& val_, std::size_t prec_, RoundingMode mode_)
+{
+	return rounded(val_, 0, false, prec_, mode_);
+}
+
+BigFloat BigFloat::to_big_float(double val_, std::size_t prec_, RoundingMode mode_)
+{
+	if (!std::isfinite(val_))
+		return rounded(BigInt(), 0, false, prec_, mode_); // nan and infinities are zero
+	int exp = 0;
+	double frac = std::frexp(val_, &exp); // (-1, -0.5] or [0.5, 1)
+	auto mant = static_cast<std::int64_t>(std::ldexp(frac, std::numeric_limits<double>::digits));
+	return rounded(BigInt::to_big_int(mant), exp - std::numeric_limits<double>::digits, false, prec_, mode_);
+}
+
+BigFloat BigFloat::to_big_float(const BigReal& val_, std::size_t prec_, RoundingMode mode_)
+{
+	// coef * 10^exp: exact product or one rounded quotient
+	std::int64_t exp = val_.exponent();
+	if (exp >= 0)
+		return rounded(val_.coefficient() * BigReal::power(10U, static_cast<std::size_t>(exp)), 0, false, prec_, mode_);
+	if (val_.is_zero())
+		return rounded(BigInt(), 0, false, prec_, mode_);
+	BigInt den = BigReal::power(10U, static_cast<std::size_t>(-(exp + 1)) + 1U);
+	return quotient(val_.coefficient(), den, 0, val_.is_neg(), prec_, mode_);
+}
+
+
+// ----------------------------------------------------------------------------
+// help
+void BigFloat::swap(BigFloat& l_val_, BigFloat& r_val_)
+{
+	using std::swap;
+	BigInt::swap(l_val_.b_mant, r_val_.b_mant);
+	swap(l_val_.b_exp, r_val_.b_exp);
+	swap(l_val_.b_prec, r_val_.b_prec);
+}
+
+std::size_t& BigFloat::start_precision()
+{
+	static std::size_t start_prec = 128U;
+	return start_prec;
+}
+
+RoundingMode& BigFloat::start_rounding_mode()
+{
+	static RoundingMode start_mode = RoundingMode::nearest_even;
+	return start_mode;
+}
+
+BigFloat::~BigFloat()
+{
+}
+
+} // end nmspc
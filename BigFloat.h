@@ -0,0 +1,117 @@
+#pragma once
+/*
+* /File: BigFloat.h /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <string>
+#include <iosfwd>
+
+#include "BigInt.h"
+
+
+namespace lez
+{
+	class BigReal; // forward declaration
+
+	enum class RoundingMode { nearest_even, toward_zero, up, down }; // up: toward +inf, down: toward -inf
+
+	// binary floating point: val = mantissa * 2^exponent, |mantissa| < 2^precision, odd (or zero)
+	// start_precision() and start_rounding_mode() edit for all class; the operators round to the larger
+	// precision of the operands, add() ... divide() take their own; every result is correctly rounded
+	// division by zero is zero! the exponent is int64 without overflow checks
+
+	class BigFloat
+	{
+	public:
+		BigFloat();
+		BigFloat(const BigFloat& val_);
+		BigFloat(BigFloat&& val_);
+		explicit BigFloat(std::int32_t val_); // start_precision(), start_rounding_mode()
+		explicit BigFloat(std::int64_t val_);
+		explicit BigFloat(const BigInt& val_);
+		explicit BigFloat(double val_); // nan and inf are zero
+		explicit BigFloat(const BigReal& val_);
+
+		BigFloat& operator=(std::int32_t val_);
+		BigFloat& operator=(std::int64_t val_);
+		BigFloat& operator=(const BigInt& val_);
+		BigFloat& operator=(double val_);
+		BigFloat& operator=(const BigReal& val_);
+		BigFloat& operator=(BigFloat val_);
+
+		BigInt to_big_int() const; // toward zero
+		BigReal to_big_real() const; // exact: 2^-k = 5^k * 10^-k
+		double to_double() const; // nearest even, subnormals included
+
+		const BigInt& mantissa() const; // signed
+		std::int64_t exponent() const;
+		std::size_t get_precision() const;
+		void set_precision(std::size_t prec_); // rounds the value with start_rounding_mode()
+		void set_precision(std::size_t prec_, RoundingMode mode_);
+		bool is_neg() const;
+		bool is_zero() const;
+		void reverse_neg();
+		void reset(); // zero, start_precision()
+
+		explicit operator bool() const;
+		explicit operator BigInt() const;
+		explicit operator double() const;
+
+		const BigFloat operator-() const;
+		const BigFloat operator+() const;
+
+		const BigFloat operator+(const BigFloat& r_val_) const;
+		const BigFloat operator-(const BigFloat& r_val_) const;
+		const BigFloat operator*(const BigFloat& r_val_) const;
+		const BigFloat operator/(const BigFloat& r_val_) const;
+
+		BigFloat& operator+=(const BigFloat& r_val_);
+		BigFloat& operator-=(const BigFloat& r_val_);
+		BigFloat& operator*=(const BigFloat& r_val_);
+		BigFloat& operator/=(const BigFloat& r_val_);
+
+		bool operator>(const BigFloat& r_val_) const;
+		bool operator<(const BigFloat& r_val_) const;
+		bool operator>=(const BigFloat& r_val_) const;
+		bool operator<=(const BigFloat& r_val_) const;
+		bool operator==(const BigFloat& r_val_) const;
+		bool operator!=(const BigFloat& r_val_) const;
+
+		std::ostream& operator<<(std::ostream& stream_) const;
+		std::string to_string() const; // d.ddde-5, enough digits for the precision (truncated)
+
+		friend std::ostream& operator<<(std::ostream& stream_, const BigFloat& bf_);
+
+		static BigFloat add(const BigFloat& l_val_, const BigFloat& r_val_, std::size_t prec_, RoundingMode mode_);
+		static BigFloat subtract(const BigFloat& l_val_, const BigFloat& r_val_, std::size_t prec_, RoundingMode mode_);
+		static BigFloat multiply(const BigFloat& l_val_, const BigFloat& r_val_, std::size_t prec_, RoundingMode mode_);
+		static BigFloat divide(const BigFloat& l_val_, const BigFloat& r_val_, std::size_t prec_, RoundingMode mode_);
+
+		static BigFloat to_big_float(const BigInt& val_, std::size_t prec_, RoundingMode mode_);
+		static BigFloat to_big_float(double val_, std::size_t prec_, RoundingMode mode_);
+		static BigFloat to_big_float(const BigReal& val_, std::size_t prec_, RoundingMode mode_);
+
+		static std::size_t& start_precision(); // lval, for all class, bits, default = 128U
+		static RoundingMode& start_rounding_mode(); // lval, for all class, default = nearest_even
+		static void swap(BigFloat& l_val_, BigFloat& r_val_);
+
+		~BigFloat();
+
+	private:
+
+		// mant_ * 2^exp_ plus something below the last bit if is_sticky_, rounded to prec_ bits
+		static BigFloat rounded(BigInt mant_, std::int64_t exp_, bool is_sticky_, std::size_t prec_, RoundingMode mode_);
+		// |num_| / |den_| * 2^exp_ with the sign of neg_, den_ != 0
+		static BigFloat quotient(const BigInt& num_, const BigInt& den_, std::int64_t exp_, bool is_neg_,
+			std::size_t prec_, RoundingMode mode_);
+		static int compare(const BigFloat& l_val_, const BigFloat& r_val_); // -1, 0, 1
+		std::int64_t top() const; // 2^(top - 1) <= |val| < 2^top
+
+		BigInt b_mant; // odd or zero
+		std::int64_t b_exp; // zero if b_mant is zero
+		std::size_t b_prec;
+	};
+}
@@ -7,30 +7,42 @@
 
 #include <utility>
 #include <cmath>
-#include <sstream>
+#include <limits>
+#include <istream>
+#include <ostream>
 #include <algorithm>
+#include <thread>
+#include <mutex>
+#include <cstring>
+#include <exception>
+#include <system_error>
 
 #include "BigInt.h"
+#include "Digits.h"
+#include "Parser.h"
+#include "Writer.h"
 
 
 namespace lez
 {
 
 BigInt::BigInt() :
-	b_num_vec(1, static_cast<std::int8_t>(0)), // default
+	b_num_vec(), // zero
 	b_is_neg(false)
 {
 }
 
 BigInt::BigInt(const BigInt& val_) :
 	b_num_vec(val_.b_num_vec),
-	b_is_neg(val_.b_is_neg)
+	b_is_neg(val_.b_is_neg),
+	b_dec_cache(is_decimal_cacheable(val_) ? std::atomic_load(&val_.b_dec_cache) : nullptr) // shared, never changed
 {
 }
 
 BigInt::BigInt(BigInt&& val_) :
 	b_num_vec(std::move(val_.b_num_vec)),
-	b_is_neg(std::move(val_.b_is_neg))
+	b_is_neg(std::move(val_.b_is_neg)),
+	b_dec_cache(std::move(val_.b_dec_cache))
 {
 }
 
@@ -40,11 +52,13 @@ BigInt::BigInt(std::int32_t val_) :
 	*this = to_big_int(val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigInt::BigInt(std::size_t val_) :
 	BigInt()
 {
 	*this = to_big_int(val_);
 }
+#endif
 
 BigInt::BigInt(std::int64_t val_) :
 	BigInt()
@@ -64,11 +78,13 @@ BigInt& BigInt::operator=(std::int32_t val_)
 	return operator=(bi);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigInt& BigInt::operator=(std::size_t val_)
 {
 	BigInt bi = to_big_int(val_);
 	return operator=(bi);
 }
+#endif
 
 BigInt& BigInt::operator=(std::int64_t val_)
 {
@@ -90,55 +106,122 @@ BigInt& BigInt::operator=(BigInt val_)
 
 std::int32_t BigInt::to_int32() const
 {
-	std::stringstream ss;
-	if (b_is_neg)
-		ss << "-";
-	for (const auto& val : b_num_vec)
-		ss << static_cast<std::int32_t>(val);
-	std::int32_t val;
-	ss >> val;
-	return val;
+	if (!fits_int32())
+		return b_is_neg ? std::numeric_limits<std::int32_t>::min() : std::numeric_limits<std::int32_t>::max();
+	return to_int32_wrapping();
 }
 
 std::size_t BigInt::to_size() const
 {
-	if (b_is_neg)
-		return static_cast<std::size_t>(to_int32());
-	std::stringstream ss;
-	for (const auto& val : b_num_vec)
-		ss << static_cast<std::int32_t>(val);
-	std::size_t val;
-	ss >> val;
-	return val;
+	if (!fits_size())
+		return b_is_neg ? 0U : std::numeric_limits<std::size_t>::max();
+	return to_size_wrapping();
 }
 
 std::int64_t BigInt::to_int64() const
 {
-	std::stringstream ss;
-	if (b_is_neg)
-		ss << "-";
-	for (const auto& val : b_num_vec)
-		ss << static_cast<std::int32_t>(val);
-	std::int64_t val;
-	ss >> val;
-	return val;
+	if (!fits_int64())
+		return b_is_neg ? std::numeric_limits<std::int64_t>::min() : std::numeric_limits<std::int64_t>::max();
+	return to_int64_wrapping();
 }
 
 std::uint64_t BigInt::to_uint64() const
 {
-	std::stringstream ss;
-	if (b_is_neg)
-		ss << "-";
-	for (const auto& val : b_num_vec)
-		ss << static_cast<std::int32_t>(val);
-	std::uint64_t val;
-	ss >> val;
-	return val;
+	if (!fits_uint64())
+		return b_is_neg ? 0U : std::numeric_limits<std::uint64_t>::max();
+	return to_uint64_wrapping();
+}
+
+std::optional<std::int32_t> BigInt::to_int32_checked() const
+{
+	if (!fits_int32())
+		return std::nullopt;
+	return to_int32_wrapping();
+}
+
+std::optional<std::size_t> BigInt::to_size_checked() const
+{
+	if (!fits_size())
+		return std::nullopt;
+	return to_size_wrapping();
+}
+
+std::optional<std::int64_t> BigInt::to_int64_checked() const
+{
+	if (!fits_int64())
+		return std::nullopt;
+	return to_int64_wrapping();
+}
+
+std::optional<std::uint64_t> BigInt::to_uint64_checked() const
+{
+	if (!fits_uint64())
+		return std::nullopt;
+	return to_uint64_wrapping();
+}
+
+std::int32_t BigInt::to_int32_wrapping() const
+{
+	return static_cast<std::int32_t>(low_bits());
+}
+
+std::size_t BigInt::to_size_wrapping() const
+{
+	return static_cast<std::size_t>(low_bits());
+}
+
+std::int64_t BigInt::to_int64_wrapping() const
+{
+	return static_cast<std::int64_t>(low_bits());
+}
+
+std::uint64_t BigInt::to_uint64_wrapping() const
+{
+	return low_bits();
+}
+
+bool BigInt::fits_int32() const
+{
+	return fits_bits(std::numeric_limits<std::int32_t>::digits, true);
+}
+
+bool BigInt::fits_size() const
+{
+	return fits_bits(std::numeric_limits<std::size_t>::digits, false);
+}
+
+bool BigInt::fits_int64() const
+{
+	return fits_bits(std::numeric_limits<std::int64_t>::digits, true);
+}
+
+bool BigInt::fits_uint64() const
+{
+	return fits_bits(std::numeric_limits<std::uint64_t>::digits, false);
+}
+
+std::uint64_t BigInt::low_bits() const
+{
+	std::uint64_t mag = 0U;
+	if (!b_num_vec.empty())
+		mag = b_num_vec[0];
+	if (b_num_vec.size() > 1U)
+		mag |= static_cast<std::uint64_t>(b_num_vec[1]) << 32U;
+	return b_is_neg ? 0U - mag : mag;
+}
+
+bool BigInt::fits_bits(std::size_t digits_, bool is_signed_) const
+{
+	std::size_t bits = bit_length();
+	if (!is_signed_)
+		return !b_is_neg && bits <= digits_;
+	// min is -2^digits_
+	return bits <= digits_ || (b_is_neg && bits == digits_ + 1U && count_trailing_zeros() == digits_);
 }
 
 std::size_t BigInt::amount_places() const
 {
-	return b_num_vec.size();
+	return to_string_unsigned().length(); // decimal digits
 }
 
 bool BigInt::is_neg() const
@@ -148,10 +231,17 @@ bool BigInt::is_neg() const
 
 bool BigInt::is_zero() const
 {
-	for (const auto& val : b_num_vec)
-		if (val != static_cast<std::int8_t>(0))
-			return false;
-	return true;
+	return b_num_vec.empty();
+}
+
+bool BigInt::is_even() const
+{
+	return b_num_vec.empty() || (b_num_vec.front() & 1U) == 0U;
+}
+
+bool BigInt::is_odd() const
+{
+	return !is_even();
 }
 
 void BigInt::reverse_neg()
@@ -226,10 +316,12 @@ BigInt::operator std::int32_t() const
 	return to_int32();
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigInt::operator std::size_t() const
 {
 	return to_size();
 }
+#endif
 
 BigInt::operator std::int64_t() const
 {
@@ -250,11 +342,13 @@ const BigInt BigInt::operator+(std::int32_t r_val_) const
 	return operator+(bi);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigInt BigInt::operator+(std::size_t r_val_) const
 {
 	BigInt bi = to_big_int(r_val_);
 	return operator+(bi);
 }
+#endif
 
 const BigInt BigInt::operator+(std::int64_t r_val_) const
 {
@@ -270,41 +364,22 @@ const BigInt BigInt::operator+(std::uint64_t r_val_) const
 
 const BigInt BigInt::operator+(const BigInt& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	BigInt cp_l_val(*this);
-	BigInt cp_r_val(r_val_);
-	if (!is_neg_l && !is_neg_r)
-	{
-		cp_l_val = addition(std::move(cp_l_val), std::move(cp_r_val));
-		return cp_l_val;
-	}
-	if (is_neg_l && is_neg_r)
-	{
-		cp_l_val = addition(std::move(cp_l_val), std::move(cp_r_val));
-		cp_l_val.b_is_neg = true;
-		return cp_l_val;
-	}
-	if (!is_neg_l && is_neg_r)
+	BigInt res;
+	if (b_is_neg == r_val_.b_is_neg)
 	{
-		cp_r_val.b_is_neg = false;
-		if (cp_l_val >= cp_r_val)
-		{
-			cp_l_val = subtraction(std::move(cp_l_val), std::move(cp_r_val));
-			return cp_l_val;
-		}
-		cp_l_val = subtraction(std::move(cp_r_val), std::move(cp_l_val));
-		cp_l_val.b_is_neg = true;
+		res = addition(*this, r_val_);
+		res.b_is_neg = b_is_neg;
+		return res;
 	}
-	cp_l_val.b_is_neg = false;
-	if (r_val_ >= cp_l_val)
+	if (!logical_less(*this, r_val_)) // |l| >= |r|, sign of l
 	{
-		cp_l_val = subtraction(std::move(cp_r_val), std::move(cp_l_val));
-		return cp_l_val;
+		res = subtraction(*this, r_val_);
+		res.b_is_neg = b_is_neg && !res.is_zero();
+		return res;
 	}
-	cp_l_val = subtraction(std::move(cp_l_val), std::move(cp_r_val));
-	cp_l_val.b_is_neg = true;
-	return cp_l_val;
+	res = subtraction(r_val_, *this);
+	res.b_is_neg = r_val_.b_is_neg;
+	return res;
 }
 
 const BigInt BigInt::operator-(std::int32_t r_val_) const
@@ -313,11 +388,13 @@ const BigInt BigInt::operator-(std::int32_t r_val_) const
 	return operator-(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigInt BigInt::operator-(std::size_t r_val_) const
 {
 	BigInt r_val = to_big_int(r_val_);
 	return operator-(r_val);
 }
+#endif
 
 const BigInt BigInt::operator-(std::int64_t r_val_) const
 {
@@ -333,26 +410,22 @@ const BigInt BigInt::operator-(std::uint64_t r_val_) const
 
 const BigInt BigInt::operator-(const BigInt& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	BigInt cp_r_val(r_val_);
-	if (!is_neg_l && !is_neg_r)
-	{
-		cp_r_val.b_is_neg = true;
-		return operator+(cp_r_val);
-	}
-	if (is_neg_l && is_neg_r)
+	BigInt res;
+	if (b_is_neg != r_val_.b_is_neg) // l - (-r) or -l - r
 	{
-		cp_r_val.b_is_neg = false;
-		return operator+(cp_r_val);
+		res = addition(*this, r_val_);
+		res.b_is_neg = b_is_neg;
+		return res;
 	}
-	if (!is_neg_l && is_neg_r)
+	if (!logical_less(*this, r_val_)) // |l| >= |r|, sign of l
 	{
-		cp_r_val.b_is_neg = false;
-		return operator+(cp_r_val);
+		res = subtraction(*this, r_val_);
+		res.b_is_neg = b_is_neg && !res.is_zero();
+		return res;
 	}
-	cp_r_val.b_is_neg = true;
-	return operator+(cp_r_val);
+	res = subtraction(r_val_, *this);
+	res.b_is_neg = !b_is_neg;
+	return res;
 }
 
 BigInt& BigInt::operator+=(std::int32_t r_val_)
@@ -361,11 +434,13 @@ BigInt& BigInt::operator+=(std::int32_t r_val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigInt& BigInt::operator+=(std::size_t r_val_)
 {
 	*this = this->operator+(r_val_);
 	return *this;
 }
+#endif
 
 BigInt& BigInt::operator+=(std::int64_t r_val_)
 {
@@ -391,11 +466,13 @@ BigInt& BigInt::operator-=(std::int32_t r_val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigInt& BigInt::operator-=(std::size_t r_val_)
 {
 	*this = this->operator-(r_val_);
 	return *this;
 }
+#endif
 
 BigInt& BigInt::operator-=(std::int64_t r_val_)
 {
@@ -420,10 +497,12 @@ const BigInt operator+(std::int32_t l_val_, const BigInt& r_val_)
 	return r_val_.operator+(l_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigInt operator+(std::size_t l_val_, const BigInt& r_val_)
 {
 	return r_val_.operator+(l_val_);
 }
+#endif
 
 const BigInt operator+(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -441,11 +520,13 @@ const BigInt operator-(std::int32_t l_val_, const BigInt& r_val_)
 	return l_val.operator-(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigInt operator-(std::size_t l_val_, const BigInt& r_val_)
 {
 	BigInt l_val = BigInt::to_big_int(l_val_);
 	return l_val.operator-(r_val_);
 }
+#endif
 
 const BigInt operator-(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -459,58 +540,42 @@ const BigInt operator-(std::uint64_t l_val_, const BigInt& r_val_)
 	return l_val.operator-(r_val_);
 }
 
-BigInt BigInt::addition(BigInt l_val_, BigInt r_val_)
+BigInt BigInt::addition(const BigInt& l_val_, const BigInt& r_val_)
 {
-	std::size_t gen_ap = (l_val_.amount_places() > r_val_.amount_places() ?
-		l_val_.amount_places() : r_val_.amount_places());
-	BigInt l_full_val = append_leading_zeros(std::move(l_val_), gen_ap);
-	BigInt r_full_val = append_leading_zeros(std::move(r_val_), gen_ap);
-	bool is_carry = false;
-	std::size_t r_i = gen_ap - 1U;
-	for (std::size_t i = 0U; i < gen_ap; ++i, --r_i)
+	const std::vector<std::uint32_t>& more = (l_val_.b_num_vec.size() >= r_val_.b_num_vec.size()) ?
+		l_val_.b_num_vec : r_val_.b_num_vec;
+	const std::vector<std::uint32_t>& less = (&more == &l_val_.b_num_vec) ?
+		r_val_.b_num_vec : l_val_.b_num_vec;
+	BigInt res;
+	res.b_num_vec.resize(more.size() + 1U);
+	std::uint64_t carry = 0U;
+	for (std::size_t i = 0U; i < more.size(); ++i)
 	{
-		if (is_carry)
-		{
-			++l_full_val.b_num_vec[r_i];
-			is_carry = false;
-		}
-		l_full_val.b_num_vec[r_i] += r_full_val.b_num_vec[r_i];
-		if (l_full_val.b_num_vec[r_i] >= static_cast<std::int8_t>(10))
-		{
-			l_full_val.b_num_vec[r_i] -= static_cast<std::int8_t>(10);
-			is_carry = true;
-		}
+		carry += more[i];
+		if (i < less.size())
+			carry += less[i];
+		res.b_num_vec[i] = static_cast<std::uint32_t>(carry);
+		carry >>= 32U;
 	}
-	if (is_carry)
-		l_full_val.b_num_vec.insert(l_full_val.b_num_vec.begin(), static_cast<std::int8_t>(1));
-	l_full_val = remove_leading_zeros(std::move(l_full_val));
-	return l_full_val;
+	res.b_num_vec.back() = static_cast<std::uint32_t>(carry);
+	res = remove_leading_zeros(std::move(res));
+	return res;
 }
 
-BigInt BigInt::subtraction(BigInt l_val_, BigInt r_val_)
+BigInt BigInt::subtraction(const BigInt& l_val_, const BigInt& r_val_)
 {
-	std::size_t gen_ap = (l_val_.amount_places() > r_val_.amount_places() ?
-		l_val_.amount_places() : r_val_.amount_places());
-	BigInt l_full_val = append_leading_zeros(std::move(l_val_), gen_ap);
-	BigInt r_full_val = append_leading_zeros(std::move(r_val_), gen_ap);
-	bool is_carry = false;
-	std::size_t r_i = gen_ap - 1U;
-	for (std::size_t i = 0U; i < gen_ap; ++i, --r_i)
+	BigInt res;
+	res.b_num_vec.resize(l_val_.b_num_vec.size());
+	std::uint32_t borrow = 0U;
+	for (std::size_t i = 0U; i < l_val_.b_num_vec.size(); ++i)
 	{
-		if (is_carry)
-		{
-			--l_full_val.b_num_vec[r_i];
-			is_carry = false;
-		}
-		l_full_val.b_num_vec[r_i] -= r_full_val.b_num_vec[r_i];
-		if (l_full_val.b_num_vec[r_i] < static_cast<std::int8_t>(0))
-		{
-			l_full_val.b_num_vec[r_i] += 10;
-			is_carry = true;
-		}
+		std::uint64_t sub = static_cast<std::uint64_t>(borrow) +
+			((i < r_val_.b_num_vec.size()) ? r_val_.b_num_vec[i] : 0U);
+		res.b_num_vec[i] = static_cast<std::uint32_t>(l_val_.b_num_vec[i] - sub);
+		borrow = (l_val_.b_num_vec[i] < sub) ? 1U : 0U;
 	}
-	l_full_val = remove_leading_zeros(std::move(l_full_val));
-	return l_full_val;
+	res = remove_leading_zeros(std::move(res));
+	return res;
 }
 
 
@@ -522,11 +587,13 @@ const BigInt BigInt::operator*(std::int32_t r_val_) const
 	return operator*(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigInt BigInt::operator*(std::size_t r_val_) const
 {
 	BigInt r_val = to_big_int(r_val_);
 	return operator*(r_val);
 }
+#endif
 
 const BigInt BigInt::operator*(std::int64_t r_val_) const
 {
@@ -542,49 +609,286 @@ const BigInt BigInt::operator*(std::uint64_t r_val_) const
 
 const BigInt BigInt::operator*(const BigInt& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	BigInt cp_l_val(*this);
-	BigInt cp_r_val(r_val_);
-	cp_l_val.b_is_neg = false;
-	cp_r_val.b_is_neg = false;
-	if (cp_l_val > cp_r_val)
-		BigInt::swap(cp_l_val, cp_r_val);
-	cp_r_val = multiplication(std::move(cp_r_val), std::move(cp_l_val));
-	if (is_neg_l == is_neg_r)
+	BigInt res = multiplication(*this, r_val_);
+	res.b_is_neg = (b_is_neg != r_val_.b_is_neg) && !res.is_zero();
+	return res;
+}
+
+BigInt BigInt::multiplication(const BigInt& l_val_, const BigInt& r_val_)
+{
+	const std::size_t karatsuba_threshold = 48U; // limbs
+	const std::size_t ntt_threshold = 1536U; // limbs
+	const std::size_t ntt_max_limbs = 1U << 21U; // per operand, keeps convolution sums below 2^85
+	if (&l_val_ == &r_val_ || l_val_.b_num_vec == r_val_.b_num_vec)
+		return square(l_val_);
+	std::size_t min_size = std::min(l_val_.b_num_vec.size(), r_val_.b_num_vec.size());
+	if (min_size < karatsuba_threshold)
+		return simple_multiplication(l_val_, r_val_);
+	if (min_size >= ntt_threshold && std::max(l_val_.b_num_vec.size(), r_val_.b_num_vec.size()) <= ntt_max_limbs)
+		return ntt_multiplication(l_val_, r_val_);
+	// (l1 * B + l0) * (r1 * B + r0), B = 2^(32 * half), three half-size products
+	std::size_t half = std::max(l_val_.b_num_vec.size(), r_val_.b_num_vec.size()) / 2U;
+	BigInt l_low, l_high, r_low, r_high;
+	split(l_val_, half, l_low, l_high);
+	split(r_val_, half, r_low, r_high);
+	BigInt low = multiplication(l_low, r_low);
+	BigInt high = multiplication(l_high, r_high);
+	BigInt mid = multiplication(addition(l_low, l_high), addition(r_low, r_high));
+	mid = subtraction(subtraction(mid, low), high);
+	BigInt res = addition(addition(high << (64U * half), mid << (32U * half)), low);
+	return res;
+}
+
+BigInt BigInt::simple_multiplication(const BigInt& l_val_, const BigInt& r_val_)
+{
+	BigInt res;
+	if (l_val_.is_zero() || r_val_.is_zero())
+		return res;
+	const std::vector<std::uint32_t>& l_vec = l_val_.b_num_vec;
+	const std::vector<std::uint32_t>& r_vec = r_val_.b_num_vec;
+	res.b_num_vec.assign(l_vec.size() + r_vec.size(), 0U);
+	for (std::size_t i = 0U; i < l_vec.size(); ++i)
 	{
-		cp_r_val.b_is_neg = false;
-		return cp_r_val;
+		std::uint64_t carry = 0U;
+		for (std::size_t j = 0U; j < r_vec.size(); ++j)
+		{
+			carry += static_cast<std::uint64_t>(l_vec[i]) * r_vec[j] + res.b_num_vec[i + j];
+			res.b_num_vec[i + j] = static_cast<std::uint32_t>(carry);
+			carry >>= 32U;
+		}
+		res.b_num_vec[i + r_vec.size()] = static_cast<std::uint32_t>(carry);
 	}
-	cp_r_val.b_is_neg = !cp_r_val.is_zero();
-	return cp_r_val;
+	res = remove_leading_zeros(std::move(res));
+	return res;
 }
 
-BigInt BigInt::multiplication(BigInt l_val_, BigInt r_val_)
+BigInt BigInt::square(const BigInt& val_)
+{
+	const std::size_t karatsuba_threshold = 64U; // limbs, squaring is cheaper
+	const std::size_t ntt_threshold = 1536U; // limbs
+	const std::size_t ntt_max_limbs = 1U << 21U; // keeps convolution sums below 2^85
+	if (val_.b_num_vec.size() < karatsuba_threshold)
+		return simple_square(val_);
+	if (val_.b_num_vec.size() >= ntt_threshold && val_.b_num_vec.size() <= ntt_max_limbs)
+		return ntt_multiplication(val_, val_);
+	// (h * B + l)^2 = h^2 * B^2 + ((h + l)^2 - h^2 - l^2) * B + l^2
+	std::size_t half = val_.b_num_vec.size() / 2U;
+	BigInt low, high;
+	split(val_, half, low, high);
+	BigInt low_sq = square(low);
+	BigInt high_sq = square(high);
+	BigInt mid = square(addition(low, high));
+	mid = subtraction(subtraction(mid, low_sq), high_sq);
+	BigInt res = addition(addition(high_sq << (64U * half), mid << (32U * half)), low_sq);
+	return res;
+}
+
+BigInt BigInt::simple_square(const BigInt& val_)
 {
 	BigInt res;
-	l_val_.b_num_vec.insert(l_val_.b_num_vec.end(), 
-		r_val_.b_num_vec.size() - 1U,
-		static_cast<std::int8_t>(0));
-	for (std::size_t i = 0U; i < r_val_.b_num_vec.size(); ++i)
+	if (val_.is_zero())
+		return res;
+	const std::vector<std::uint32_t>& vec = val_.b_num_vec;
+	std::size_t size = vec.size();
+	res.b_num_vec.assign(2U * size, 0U);
+	// cross products a_i * a_j (i < j) once
+	for (std::size_t i = 0U; i < size; ++i)
+	{
+		std::uint64_t carry = 0U;
+		for (std::size_t j = i + 1U; j < size; ++j)
+		{
+			carry += static_cast<std::uint64_t>(vec[i]) * vec[j] + res.b_num_vec[i + j];
+			res.b_num_vec[i + j] = static_cast<std::uint32_t>(carry);
+			carry >>= 32U;
+		}
+		res.b_num_vec[i + size] = static_cast<std::uint32_t>(carry);
+	}
+	// doubled, plus squares on the diagonal
+	std::uint64_t carry = 0U;
+	std::uint32_t top_bit = 0U;
+	for (std::size_t i = 0U; i < size; ++i)
+	{
+		std::uint64_t sq = static_cast<std::uint64_t>(vec[i]) * vec[i];
+		std::uint32_t lo = res.b_num_vec[2U * i];
+		std::uint32_t hi = res.b_num_vec[2U * i + 1U];
+		carry += static_cast<std::uint64_t>((lo << 1U) | top_bit) + static_cast<std::uint32_t>(sq);
+		res.b_num_vec[2U * i] = static_cast<std::uint32_t>(carry);
+		carry >>= 32U;
+		carry += static_cast<std::uint64_t>((hi << 1U) | (lo >> 31U)) + (sq >> 32U);
+		res.b_num_vec[2U * i + 1U] = static_cast<std::uint32_t>(carry);
+		carry >>= 32U;
+		top_bit = hi >> 31U;
+	}
+	res = remove_leading_zeros(std::move(res));
+	return res;
+}
+
+BigInt BigInt::ntt_multiplication(const BigInt& l_val_, const BigInt& r_val_)
+{
+	// cyclic convolution of the limbs modulo three primes, CRT back (exact below 2^85)
+	const std::uint32_t primes[3] = { 998244353U, 167772161U, 469762049U };
+	bool is_square = (&l_val_ == &r_val_);
+	std::size_t len = 1U;
+	while (len < l_val_.b_num_vec.size() + r_val_.b_num_vec.size())
+		len <<= 1U;
+	std::vector<std::uint32_t> conv[3];
+	parallel_for(3U, 2U * len, [&](std::size_t k_) {
+		std::uint32_t prime = primes[k_];
+		auto to_residues = [len, prime](const BigInt& val_) {
+			std::vector<std::uint32_t> res(len, 0U);
+			for (std::size_t i = 0U; i < val_.b_num_vec.size(); ++i)
+				res[i] = val_.b_num_vec[i] % prime;
+			return res;
+		};
+		std::vector<std::uint32_t> l_res = to_residues(l_val_);
+		ntt(l_res, prime, false);
+		if (is_square)
+			for (auto& val : l_res)
+				val = static_cast<std::uint32_t>(static_cast<std::uint64_t>(val) * val % prime);
+		else
+		{
+			std::vector<std::uint32_t> r_res = to_residues(r_val_);
+			ntt(r_res, prime, false);
+			for (std::size_t i = 0U; i < len; ++i)
+				l_res[i] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(l_res[i]) * r_res[i] % prime);
+		}
+		ntt(l_res, prime, true);
+		conv[k_] = std::move(l_res);
+	});
+
+	// x = a_0 + p_0 * t_1 + p_0 * p_1 * t_2 < 2^86, kept as two 64-bit words
+	const std::uint64_t p0 = primes[0], p1 = primes[1], p2 = primes[2];
+	const std::uint64_t p01 = p0 * p1;
+	const std::uint64_t inv_p0_p1 = pow_mod(p0, p1 - 2U, primes[1]);
+	const std::uint64_t inv_p01_p2 = pow_mod(p01 % p2, p2 - 2U, primes[2]);
+	BigInt res;
+	res.b_num_vec.resize(len);
+	std::uint64_t carry_lo = 0U, carry_hi = 0U;
+	for (std::size_t i = 0U; i < len; ++i)
+	{
+		std::uint64_t a0 = conv[0][i], a1 = conv[1][i], a2 = conv[2][i];
+		std::uint64_t t1 = (a1 + p1 - a0 % p1) % p1 * inv_p0_p1 % p1;
+		std::uint64_t low = a0 + p0 * t1; // < 2^60
+		std::uint64_t t2 = (a2 + p2 - low % p2) % p2 * inv_p01_p2 % p2;
+		std::uint64_t part_lo = (p01 & 0xFFFFFFFFU) * t2;
+		std::uint64_t part_hi = (p01 >> 32U) * t2;
+		std::uint64_t x_lo = part_lo + (part_hi << 32U);
+		std::uint64_t x_hi = (part_hi >> 32U) + ((x_lo < part_lo) ? 1U : 0U);
+		x_lo += low;
+		x_hi += (x_lo < low) ? 1U : 0U;
+		x_lo += carry_lo;
+		x_hi += carry_hi + ((x_lo < carry_lo) ? 1U : 0U);
+		res.b_num_vec[i] = static_cast<std::uint32_t>(x_lo);
+		carry_lo = (x_lo >> 32U) | (x_hi << 32U);
+		carry_hi = x_hi >> 32U;
+	}
+	res = remove_leading_zeros(std::move(res));
+	return res;
+}
+
+void BigInt::ntt(std::vector<std::uint32_t>& vec_, std::uint32_t prime_, bool is_inverse_)
+{
+	// forward: decimation in frequency, natural order in, bit-reversed out;
+	// inverse: decimation in time, bit-reversed in, natural out, so no permutation at all
+	// Montgomery products (R = 2^32): values in normal form, roots in Montgomery form
+	std::uint32_t prime_inv = prime_; // prime_^-1 mod 2^32
+	for (std::size_t i = 0U; i < 4U; ++i)
+		prime_inv *= 2U - prime_ * prime_inv;
+	const std::uint32_t neg_prime_inv = 0U - prime_inv;
+	auto reduce = [prime_, neg_prime_inv](std::uint64_t val_) {
+		std::uint32_t m = static_cast<std::uint32_t>(val_) * neg_prime_inv;
+		std::uint32_t res = static_cast<std::uint32_t>((val_ + static_cast<std::uint64_t>(m) * prime_) >> 32U);
+		return (res >= prime_) ? res - prime_ : res;
+	};
+	const std::uint64_t r_mod = (static_cast<std::uint64_t>(1U) << 32U) % prime_;
+	std::size_t len = vec_.size();
+	// roots[half + j] = w^j, w of order 2 * half; 3 generates the group for all three primes
+	std::vector<std::uint32_t> roots(std::max<std::size_t>(len, 2U));
+	for (std::size_t half = 1U; half < len; half <<= 1U)
+	{
+		std::uint64_t root = pow_mod(3U, (prime_ - 1U) / (2U * half), prime_);
+		if (is_inverse_)
+			root = pow_mod(root, prime_ - 2U, prime_);
+		std::uint64_t root_m = root * r_mod % prime_;
+		std::uint32_t w = static_cast<std::uint32_t>(r_mod); // one
+		for (std::size_t j = 0U; j < half; ++j)
+		{
+			roots[half + j] = w;
+			w = reduce(static_cast<std::uint64_t>(w) * root_m);
+		}
+	}
+	if (!is_inverse_)
+		for (std::size_t half = len >> 1U; half != 0U; half >>= 1U)
+			for (std::size_t i = 0U; i < len; i += 2U * half)
+			{
+				std::uint32_t* low = &vec_[i];
+				std::uint32_t* high = low + half;
+				const std::uint32_t* w = &roots[half];
+				for (std::size_t j = 0U; j < half; ++j)
+				{
+					std::uint32_t u = low[j];
+					std::uint32_t v = high[j];
+					std::uint32_t sum = u + v;
+					low[j] = (sum >= prime_) ? sum - prime_ : sum;
+					high[j] = reduce(static_cast<std::uint64_t>(u + prime_ - v) * w[j]);
+				}
+			}
+	else
 	{
-		res += simple_multiplication(l_val_, static_cast<std::int32_t>(r_val_.b_num_vec[i]));
-		l_val_.b_num_vec.pop_back();
+		for (std::size_t half = 1U; half < len; half <<= 1U)
+			for (std::size_t i = 0U; i < len; i += 2U * half)
+			{
+				std::uint32_t* low = &vec_[i];
+				std::uint32_t* high = low + half;
+				const std::uint32_t* w = &roots[half];
+				for (std::size_t j = 0U; j < half; ++j)
+				{
+					std::uint32_t u = low[j];
+					std::uint32_t v = reduce(static_cast<std::uint64_t>(high[j]) * w[j]);
+					std::uint32_t sum = u + v;
+					low[j] = (sum >= prime_) ? sum - prime_ : sum;
+					high[j] = (u >= v) ? u - v : u + prime_ - v;
+				}
+			}
+		std::uint64_t inv_len = pow_mod(len % prime_, prime_ - 2U, prime_) * r_mod % prime_;
+		for (auto& val : vec_)
+			val = reduce(val * inv_len);
 	}
+}
+
+std::uint64_t BigInt::pow_mod(std::uint64_t base_, std::uint64_t exp_, std::uint32_t mod_)
+{
+	std::uint64_t res = 1U;
+	base_ %= mod_;
+	for (; exp_ != 0U; exp_ >>= 1U, base_ = base_ * base_ % mod_)
+		if ((exp_ & 1U) != 0U)
+			res = res * base_ % mod_;
 	return res;
 }
 
-BigInt BigInt::simple_multiplication(BigInt val_, std::int32_t counter_)
+void BigInt::split(const BigInt& val_, std::size_t am_limbs_, BigInt& low_, BigInt& high_)
 {
-	BigInt cp_val(val_);
-	if (counter_ == 0)
-		val_.reset();
-	while (counter_ > 1)
+	std::size_t pos = std::min(am_limbs_, val_.b_num_vec.size());
+	low_.b_num_vec.assign(val_.b_num_vec.begin(), val_.b_num_vec.begin() + pos);
+	high_.b_num_vec.assign(val_.b_num_vec.begin() + pos, val_.b_num_vec.end());
+	low_.b_is_neg = false;
+	high_.b_is_neg = false;
+	low_ = remove_leading_zeros(std::move(low_));
+}
+
+void BigInt::simple_multiplication(BigInt& val_, std::uint32_t mul_, std::uint32_t add_)
+{
+	val_.b_dec_cache.reset(); // the limbs change in place
+	std::uint64_t carry = add_;
+	for (auto& limb : val_.b_num_vec)
 	{
-		val_.operator+=(cp_val);
-		--counter_;
+		carry += static_cast<std::uint64_t>(limb) * mul_;
+		limb = static_cast<std::uint32_t>(carry);
+		carry >>= 32U;
 	}
-	return val_;
+	if (carry != 0U)
+		val_.b_num_vec.push_back(static_cast<std::uint32_t>(carry));
+	val_ = remove_leading_zeros(std::move(val_)); // mul_ == 0
 }
 
 const BigInt BigInt::operator/(std::int32_t r_val_) const
@@ -593,11 +897,13 @@ const BigInt BigInt::operator/(std::int32_t r_val_) const
 	return operator/(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigInt BigInt::operator/(std::size_t r_val_) const
 {
 	BigInt r_val = to_big_int(r_val_);
 	return operator/(r_val);
 }
+#endif
 
 const BigInt BigInt::operator/(std::int64_t r_val_) const
 {
@@ -613,56 +919,205 @@ const BigInt BigInt::operator/(std::uint64_t r_val_) const
 
 const BigInt BigInt::operator/(const BigInt& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	BigInt cp_l_val(*this);
-	BigInt cp_r_val(r_val_);
-	cp_l_val.b_is_neg = false;
-	cp_r_val.b_is_neg = false;
 	if (r_val_.is_zero()) // division by zero
 		return BigInt(); // ret zero
-	if (cp_l_val < cp_r_val) // private case
-		return BigInt(); 
-	cp_r_val = division(std::move(cp_l_val), std::move(cp_r_val));
-	if (is_neg_l == is_neg_r)
+	if (logical_less(*this, r_val_)) // private case
+		return BigInt();
+	BigInt res = division(*this, r_val_);
+	res.b_is_neg = (b_is_neg != r_val_.b_is_neg) && !res.is_zero();
+	return res;
+}
+
+BigInt BigInt::division(const BigInt& l_val_, const BigInt& r_val_)
+{
+	BigInt quot, rem;
+	division_with_remainder(l_val_, r_val_, quot, rem);
+	return quot;
+}
+
+void BigInt::division_with_remainder(const BigInt& l_val_, const BigInt& r_val_, BigInt& quot_, BigInt& rem_)
+{
+	if (r_val_.b_num_vec.size() < newton_threshold || logical_less(l_val_, r_val_))
+	{
+		long_division(l_val_, r_val_, quot_, rem_);
+		return;
+	}
+	// normalize so that the top limb of the divisor has its high bit set
+	std::size_t shift = 32U - limb_bit_length(r_val_.b_num_vec.back());
+	BigInt r_val(r_val_);
+	r_val.b_is_neg = false;
+	r_val <<= shift;
+	newton_division(l_val_, r_val_, reciprocal(r_val), quot_, rem_);
+}
+
+void BigInt::newton_division(const BigInt& l_val_, const BigInt& r_val_, const BigInt& inv_, BigInt& quot_, BigInt& rem_)
+{
+	std::size_t shift = 32U - limb_bit_length(r_val_.b_num_vec.back());
+	BigInt l_val(l_val_);
+	BigInt r_val(r_val_);
+	l_val.b_is_neg = false;
+	r_val.b_is_neg = false;
+	l_val <<= shift;
+	r_val <<= shift;
+	// n-limb blocks from the top: q = (rem * B^n + block) * inv_ / B^2n is off by a few units
+	std::size_t n = r_val.b_num_vec.size();
+	std::size_t am_blocks = (l_val.b_num_vec.size() + n - 1U) / n;
+	BigInt low, rem;
+	split(l_val, n * (am_blocks - 1U), low, rem); // rem = top block
+	if (logical_less(rem, r_val))
+		--am_blocks;
+	else
+		rem = BigInt();
+	quot_.b_num_vec.assign(n * am_blocks, 0U);
+	quot_.b_is_neg = false;
+	for (std::size_t i = am_blocks; i-- != 0U;)
 	{
-		cp_r_val.b_is_neg = false;
-		return cp_r_val;
+		BigInt block;
+		block.b_num_vec.assign(l_val.b_num_vec.begin() + n * i,
+			l_val.b_num_vec.begin() + std::min(n * (i + 1U), l_val.b_num_vec.size()));
+		block = remove_leading_zeros(std::move(block));
+		BigInt cur = addition(rem << (32U * n), block);
+		BigInt quot = multiplication(cur >> (32U * (n - 1U)), inv_) >> (32U * (n + 1U)); // top limbs are enough
+		rem = cur - multiplication(quot, r_val);
+		while (rem.b_is_neg)
+		{
+			rem += r_val;
+			--quot;
+		}
+		while (!logical_less(rem, r_val))
+		{
+			rem = subtraction(rem, r_val);
+			++quot;
+		}
+		std::copy(quot.b_num_vec.begin(), quot.b_num_vec.end(), quot_.b_num_vec.begin() + n * i);
 	}
-	cp_r_val.b_is_neg = !cp_r_val.is_zero();
-	return cp_r_val;
+	quot_ = remove_leading_zeros(std::move(quot_));
+	rem_ = rem >> shift;
 }
 
-BigInt BigInt::division(BigInt l_val_, BigInt r_val_)
+BigInt BigInt::reciprocal(const BigInt& val_)
 {
+	// floor(B^2n / val_) up to a few units, Newton: each step doubles the correct limbs
+	std::size_t n = val_.b_num_vec.size();
 	BigInt res;
-	BigInt cp_part_res;
-	std::size_t am_zeros = l_val_.b_num_vec.size() - r_val_.b_num_vec.size(); // max size
-	r_val_.b_num_vec.insert(r_val_.b_num_vec.end(), am_zeros, static_cast<std::int8_t>(0));
-	while (am_zeros != 0)
-	{
-		cp_part_res = simple_division(l_val_, r_val_);
-		cp_part_res.b_num_vec.insert(cp_part_res.b_num_vec.end(),
-			am_zeros,
-			static_cast<std::int8_t>(0));
-		res += cp_part_res;
-		r_val_.b_num_vec.pop_back();
-		--am_zeros;
-	}
-	res += simple_division(l_val_, r_val_);
+	if (n < newton_threshold)
+	{
+		BigInt power, rem;
+		power.b_num_vec.assign(2U * n, 0U);
+		power.b_num_vec.push_back(1U); // B^2n
+		long_division(power, val_, res, rem);
+		return res;
+	}
+	std::size_t k = n / 2U + 1U; // one guard limb keeps the error from growing
+	BigInt inv_high = reciprocal(val_ >> (32U * (n - k))); // v = B^2k / high
+	// res = v * B^(n-k) + v * (B^(n+k) - val_ * v) / B^2k, low limbs of the error do not matter
+	BigInt err;
+	err.b_num_vec.assign(n + k, 0U);
+	err.b_num_vec.push_back(1U); // B^(n+k)
+	err -= multiplication(val_, inv_high);
+	err >>= 32U * (k - 1U);
+	res = (inv_high << (32U * (n - k))) + ((inv_high * err) >> (32U * (k + 1U)));
 	return res;
 }
 
-std::int32_t BigInt::simple_division(BigInt& val_, const BigInt& subthd_)
+void BigInt::long_division(const BigInt& l_val_, const BigInt& r_val_, BigInt& quot_, BigInt& rem_)
 {
-	std::int32_t res = -1;
-	while (!val_.is_neg())
+	if (logical_less(l_val_, r_val_))
 	{
-		val_ -= subthd_;
-		++res;
+		quot_ = BigInt();
+		rem_ = l_val_;
+		rem_.b_is_neg = false;
+		return;
 	}
-	val_ += subthd_; // ret remainder
-	return res;
+	if (r_val_.b_num_vec.size() == 1U)
+	{
+		quot_ = l_val_;
+		quot_.b_is_neg = false;
+		rem_ = to_big_int_from_magnitude(simple_division(quot_, r_val_.b_num_vec.front()), false);
+		return;
+	}
+	// Knuth, algorithm D: normalize so that the top limb of the divisor has its high bit set
+	std::size_t n = r_val_.b_num_vec.size();
+	std::size_t m = l_val_.b_num_vec.size() - n;
+	std::size_t shift = 32U - limb_bit_length(r_val_.b_num_vec.back());
+	std::vector<std::uint32_t> vn(n);
+	std::vector<std::uint32_t> un(m + n + 1U);
+	for (std::size_t i = n - 1U; i != 0U; --i)
+		vn[i] = (r_val_.b_num_vec[i] << shift) |
+			((shift != 0U) ? r_val_.b_num_vec[i - 1U] >> (32U - shift) : 0U);
+	vn[0] = r_val_.b_num_vec[0] << shift;
+	un[m + n] = (shift != 0U) ? l_val_.b_num_vec[m + n - 1U] >> (32U - shift) : 0U;
+	for (std::size_t i = m + n - 1U; i != 0U; --i)
+		un[i] = (l_val_.b_num_vec[i] << shift) |
+			((shift != 0U) ? l_val_.b_num_vec[i - 1U] >> (32U - shift) : 0U);
+	un[0] = l_val_.b_num_vec[0] << shift;
+
+	const std::uint64_t base = 0x100000000U;
+	quot_.b_num_vec.assign(m + 1U, 0U);
+	quot_.b_is_neg = false;
+	for (std::size_t j = m + 1U; j-- != 0U;)
+	{
+		// estimate, at most 2 too big
+		std::uint64_t num = (static_cast<std::uint64_t>(un[j + n]) << 32U) | un[j + n - 1U];
+		std::uint64_t qhat = num / vn[n - 1U];
+		std::uint64_t rhat = num % vn[n - 1U];
+		while (qhat >= base || qhat * vn[n - 2U] > ((rhat << 32U) | un[j + n - 2U]))
+		{
+			--qhat;
+			rhat += vn[n - 1U];
+			if (rhat >= base)
+				break;
+		}
+		// un[j..j+n] -= qhat * vn
+		std::uint64_t carry = 0U;
+		std::uint32_t borrow = 0U;
+		for (std::size_t i = 0U; i < n; ++i)
+		{
+			std::uint64_t prod = qhat * vn[i] + carry;
+			carry = prod >> 32U;
+			std::uint64_t sub = (prod & 0xFFFFFFFFU) + borrow;
+			borrow = (un[i + j] < sub) ? 1U : 0U;
+			un[i + j] = static_cast<std::uint32_t>(un[i + j] - sub);
+		}
+		std::uint64_t sub = carry + borrow;
+		bool is_neg = un[j + n] < sub;
+		un[j + n] = static_cast<std::uint32_t>(un[j + n] - sub);
+		if (is_neg) // add back, rare
+		{
+			--qhat;
+			std::uint64_t add_carry = 0U;
+			for (std::size_t i = 0U; i < n; ++i)
+			{
+				add_carry += static_cast<std::uint64_t>(un[i + j]) + vn[i];
+				un[i + j] = static_cast<std::uint32_t>(add_carry);
+				add_carry >>= 32U;
+			}
+			un[j + n] += static_cast<std::uint32_t>(add_carry);
+		}
+		quot_.b_num_vec[j] = static_cast<std::uint32_t>(qhat);
+	}
+	quot_ = remove_leading_zeros(std::move(quot_));
+	// denormalize the remainder
+	rem_.b_num_vec.resize(n);
+	rem_.b_is_neg = false;
+	for (std::size_t i = 0U; i < n; ++i)
+		rem_.b_num_vec[i] = (un[i] >> shift) |
+			((shift != 0U) ? un[i + 1U] << (32U - shift) : 0U);
+	rem_ = remove_leading_zeros(std::move(rem_));
+}
+
+std::uint32_t BigInt::simple_division(BigInt& val_, std::uint32_t div_)
+{
+	val_.b_dec_cache.reset(); // the limbs change in place
+	std::uint64_t rem = 0U;
+	for (std::size_t i = val_.b_num_vec.size(); i-- != 0U;)
+	{
+		rem = (rem << 32U) | val_.b_num_vec[i];
+		val_.b_num_vec[i] = static_cast<std::uint32_t>(rem / div_);
+		rem %= div_;
+	}
+	val_ = remove_leading_zeros(std::move(val_));
+	return static_cast<std::uint32_t>(rem);
 }
 
 const BigInt BigInt::operator%(std::int32_t r_val_) const
@@ -671,11 +1126,13 @@ const BigInt BigInt::operator%(std::int32_t r_val_) const
 	return operator%(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigInt BigInt::operator%(std::size_t r_val_) const
 {
 	BigInt r_val = to_big_int(r_val_);
 	return operator%(r_val);
 }
+#endif
 
 const BigInt BigInt::operator%(std::int64_t r_val_) const
 {
@@ -691,38 +1148,20 @@ const BigInt BigInt::operator%(std::uint64_t r_val_) const
 
 const BigInt BigInt::operator%(const BigInt& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	BigInt cp_l_val(*this);
-	BigInt cp_r_val(r_val_);
-	cp_l_val.b_is_neg = false;
-	cp_r_val.b_is_neg = false;
-	if (cp_r_val == 0) // remainder of division by zero
+	if (r_val_.is_zero()) // remainder of division by zero
 		return BigInt(); // ret zero
-	if (cp_l_val < cp_r_val)
-		return cp_l_val;
-	cp_r_val = modulo_division(std::move(cp_l_val), std::move(cp_r_val));
-	if (!is_neg_l)
-	{
-		cp_r_val.b_is_neg = false;
-		return cp_r_val;
-	}
-	cp_r_val.b_is_neg = !cp_r_val.is_zero();
-	return cp_r_val;
+	if (logical_less(*this, r_val_)) // |l| < |r|: l itself, sign included
+		return *this;
+	BigInt res = modulo_division(*this, r_val_);
+	res.b_is_neg = b_is_neg && !res.is_zero(); // sign of l
+	return res;
 }
 
-BigInt BigInt::modulo_division(BigInt l_val_, BigInt r_val_)
+BigInt BigInt::modulo_division(const BigInt& l_val_, const BigInt& r_val_)
 {
-	std::size_t am_zeros = l_val_.b_num_vec.size() - r_val_.b_num_vec.size(); // max size
-	r_val_.b_num_vec.insert(r_val_.b_num_vec.end(), am_zeros, static_cast<std::int8_t>(0));
-	while (am_zeros != 0)
-	{
-		simple_division(l_val_, r_val_);
-		r_val_.b_num_vec.pop_back();
-		--am_zeros;
-	}
-	simple_division(l_val_, r_val_);
-	return l_val_;
+	BigInt quot, rem;
+	division_with_remainder(l_val_, r_val_, quot, rem);
+	return rem;
 }
 
 BigInt& BigInt::operator*=(std::int32_t r_val_)
@@ -731,11 +1170,13 @@ BigInt& BigInt::operator*=(std::int32_t r_val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigInt& BigInt::operator*=(std::size_t r_val_)
 {
 	*this = this->operator*(r_val_);
 	return *this;
 }
+#endif
 
 BigInt& BigInt::operator*=(std::int64_t r_val_)
 {
@@ -761,11 +1202,13 @@ BigInt& BigInt::operator/=(std::int32_t r_val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigInt& BigInt::operator/=(std::size_t r_val_)
 {
 	*this = this->operator/(r_val_);
 	return *this;
 }
+#endif
 
 BigInt& BigInt::operator/=(std::int64_t r_val_)
 {
@@ -791,11 +1234,13 @@ BigInt& BigInt::operator%=(std::int32_t r_val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigInt& BigInt::operator%=(std::size_t r_val_)
 {
 	*this = this->operator%(r_val_);
 	return *this;
 }
+#endif
 
 BigInt& BigInt::operator%=(std::int64_t r_val_)
 {
@@ -820,10 +1265,12 @@ const BigInt operator*(std::int32_t l_val_, const BigInt& r_val_)
 	return r_val_.operator*(l_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigInt operator*(std::size_t l_val_, const BigInt& r_val_)
 {
 	return r_val_.operator*(l_val_);
 }
+#endif
 
 const BigInt operator*(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -841,11 +1288,13 @@ const BigInt operator/(std::int32_t l_val_, const BigInt& r_val_)
 	return l_val.operator/(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigInt operator/(std::size_t l_val_, const BigInt& r_val_)
 {
 	BigInt l_val = BigInt::to_big_int(l_val_);
 	return l_val.operator/(r_val_);
 }
+#endif
 
 const BigInt operator/(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -865,11 +1314,13 @@ const BigInt operator%(std::int32_t l_val_, const BigInt& r_val_)
 	return l_val.operator%(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigInt operator%(std::size_t l_val_, const BigInt& r_val_)
 {
 	BigInt l_val = BigInt::to_big_int(l_val_);
 	return l_val.operator%(r_val_);
 }
+#endif
 
 const BigInt operator%(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -892,11 +1343,13 @@ bool BigInt::operator>(std::int32_t r_val_) const
 	return operator>(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigInt::operator>(std::size_t r_val_) const
 {
 	BigInt r_val = to_big_int(r_val_);
 	return operator>(r_val);
 }
+#endif
 
 bool BigInt::operator>(std::int64_t r_val_) const
 {
@@ -912,35 +1365,16 @@ bool BigInt::operator>(std::uint64_t r_val_) const
 
 bool BigInt::operator>(const BigInt& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	if (is_neg_l && !is_neg_r)
-		return false;
-	if (!is_neg_l && is_neg_r)
-		return true;
-	if (this->operator==(r_val_))
-		return false;
-	if (!is_neg_l && !is_neg_r)
+	if (b_is_neg != r_val_.b_is_neg)
+		return r_val_.b_is_neg;
+	if (!b_is_neg)
 		return logical_more(*this, r_val_);
-	return !logical_more(*this, r_val_);
+	return logical_less(*this, r_val_);
 }
 
-bool BigInt::logical_more(BigInt l_val_, BigInt r_val_)
+bool BigInt::logical_more(const BigInt& l_val_, const BigInt& r_val_)
 {
-	std::size_t gen_ap = (l_val_.amount_places() > r_val_.amount_places() ?
-		l_val_.amount_places() : r_val_.amount_places());
-	BigInt l_full_val = append_leading_zeros(std::move(l_val_), gen_ap);
-	BigInt r_full_val = append_leading_zeros(std::move(r_val_), gen_ap);
-	bool is_more = false;
-	std::size_t r_i = gen_ap - 1U;
-	for (std::size_t i = 0U; i < gen_ap; ++i, --r_i)
-	{
-		if (l_full_val.b_num_vec[r_i] > r_full_val.b_num_vec[r_i])
-			is_more = true;
-		else if (l_full_val.b_num_vec[r_i] < r_full_val.b_num_vec[r_i])
-			is_more = false;
-	}
-	return is_more;
+	return logical_less(r_val_, l_val_);
 }
 
 bool BigInt::operator<(std::int32_t r_val_) const
@@ -949,11 +1383,13 @@ bool BigInt::operator<(std::int32_t r_val_) const
 	return operator<(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigInt::operator<(std::size_t r_val_) const
 {
 	BigInt r_val = to_big_int(r_val_);
 	return operator<(r_val);
 }
+#endif
 
 bool BigInt::operator<(std::int64_t r_val_) const
 {
@@ -969,35 +1405,21 @@ bool BigInt::operator<(std::uint64_t r_val_) const
 
 bool BigInt::operator<(const BigInt& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	if (is_neg_l && !is_neg_r)
-		return true;
-	if (!is_neg_l && is_neg_r)
-		return false;
-	if (this->operator==(r_val_))
-		return false;
-	if (!is_neg_l && !is_neg_r)
+	if (b_is_neg != r_val_.b_is_neg)
+		return b_is_neg;
+	if (!b_is_neg)
 		return logical_less(*this, r_val_);
-	return !logical_less(*this, r_val_);
+	return logical_more(*this, r_val_);
 }
 
-bool BigInt::logical_less(BigInt l_val_, BigInt r_val_)
+bool BigInt::logical_less(const BigInt& l_val_, const BigInt& r_val_)
 {
-	std::size_t gen_ap = (l_val_.amount_places() > r_val_.amount_places() ?
-		l_val_.amount_places() : r_val_.amount_places());
-	BigInt l_full_val = append_leading_zeros(std::move(l_val_), gen_ap);
-	BigInt r_full_val = append_leading_zeros(std::move(r_val_), gen_ap);
-	bool is_less = false;
-	std::size_t r_i = gen_ap - 1U;
-	for (std::size_t i = 0U; i < gen_ap; ++i, --r_i)
-	{
-		if (l_full_val.b_num_vec[r_i] < r_full_val.b_num_vec[r_i])
-			is_less = true;
-		else if (l_full_val.b_num_vec[r_i] > r_full_val.b_num_vec[r_i])
-			is_less = false;
-	}
-	return is_less;
+	if (l_val_.b_num_vec.size() != r_val_.b_num_vec.size())
+		return l_val_.b_num_vec.size() < r_val_.b_num_vec.size();
+	for (std::size_t i = l_val_.b_num_vec.size(); i-- != 0U;)
+		if (l_val_.b_num_vec[i] != r_val_.b_num_vec[i])
+			return l_val_.b_num_vec[i] < r_val_.b_num_vec[i];
+	return false;
 }
 
 bool BigInt::operator>=(std::int32_t r_val_) const
@@ -1005,10 +1427,12 @@ bool BigInt::operator>=(std::int32_t r_val_) const
 	return !operator<(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigInt::operator>=(std::size_t r_val_) const
 {
 	return !operator<(r_val_);
 }
+#endif
 
 bool BigInt::operator>=(std::int64_t r_val_) const
 {
@@ -1030,10 +1454,12 @@ bool BigInt::operator<=(std::int32_t r_val_) const
 	return !operator>(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigInt::operator<=(std::size_t r_val_) const
 {
 	return !operator>(r_val_);
 }
+#endif
 
 bool BigInt::operator<=(std::int64_t r_val_) const
 {
@@ -1056,11 +1482,13 @@ bool BigInt::operator==(std::int32_t r_val_) const
 	return operator==(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigInt::operator==(std::size_t r_val_) const
 {
 	BigInt r_val = to_big_int(r_val_);
 	return operator==(r_val);
 }
+#endif
 
 bool BigInt::operator==(std::int64_t r_val_) const
 {
@@ -1076,25 +1504,14 @@ bool BigInt::operator==(std::uint64_t r_val_) const
 
 bool BigInt::operator==(const BigInt& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	if (is_neg_l && !is_neg_r)
-		return false;
-	if (!is_neg_l && is_neg_r)
+	if (b_is_neg != r_val_.b_is_neg)
 		return false;
 	return logical_equal(*this, r_val_);
 }
 
-bool BigInt::logical_equal(BigInt l_val_, BigInt r_val_)
+bool BigInt::logical_equal(const BigInt& l_val_, const BigInt& r_val_)
 {
-	if (l_val_.b_num_vec.size() != r_val_.b_num_vec.size())
-		return false;
-	bool is_equal = true;
-	std::size_t r_i = l_val_.b_num_vec.size() - 1U;
-	for (std::size_t i = 0U; is_equal && i < l_val_.b_num_vec.size(); ++i, --r_i)
-		if (l_val_.b_num_vec[r_i] != r_val_.b_num_vec[r_i])
-			is_equal = false;
-	return is_equal;
+	return l_val_.b_num_vec == r_val_.b_num_vec;
 }
 
 bool BigInt::operator!=(std::int32_t r_val_) const
@@ -1102,10 +1519,12 @@ bool BigInt::operator!=(std::int32_t r_val_) const
 	return !operator==(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigInt::operator!=(std::size_t r_val_) const
 {
 	return !operator==(r_val_);
 }
+#endif
 
 bool BigInt::operator!=(std::int64_t r_val_) const
 {
@@ -1127,10 +1546,12 @@ bool operator>(std::int32_t l_val_, const BigInt& r_val_)
 	return r_val_.operator<(l_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator>(std::size_t l_val_, const BigInt& r_val_)
 {
 	return r_val_.operator<(l_val_);
 }
+#endif
 
 bool operator>(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -1147,10 +1568,12 @@ bool operator<(std::int32_t l_val_, const BigInt& r_val_)
 	return r_val_.operator>(l_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator<(std::size_t l_val_, const BigInt& r_val_)
 {
 	return r_val_.operator>(l_val_);
 }
+#endif
 
 bool operator<(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -1167,10 +1590,12 @@ bool operator>=(std::int32_t l_val_, const BigInt& r_val_)
 	return !r_val_.operator>(l_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator>=(std::size_t l_val_, const BigInt& r_val_)
 {
 	return !r_val_.operator>(l_val_);
 }
+#endif
 
 bool operator>=(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -1187,10 +1612,12 @@ bool operator<=(std::int32_t l_val_, const BigInt& r_val_)
 	return !r_val_.operator<(l_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator<=(std::size_t l_val_, const BigInt& r_val_)
 {
 	return !r_val_.operator<(l_val_);
 }
+#endif
 
 bool operator<=(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -1207,10 +1634,12 @@ bool operator==(std::int32_t l_val_, const BigInt& r_val_)
 	return r_val_.operator==(l_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator==(std::size_t l_val_, const BigInt& r_val_)
 {
 	return r_val_.operator==(l_val_);
 }
+#endif
 
 bool operator==(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -1227,10 +1656,12 @@ bool operator!=(std::int32_t l_val_, const BigInt& r_val_)
 	return r_val_.operator!=(l_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator!=(std::size_t l_val_, const BigInt& r_val_)
 {
 	return r_val_.operator!=(l_val_);
 }
+#endif
 
 bool operator!=(std::int64_t l_val_, const BigInt& r_val_)
 {
@@ -1244,209 +1675,1560 @@ bool operator!=(std::uint64_t l_val_, const BigInt& r_val_)
 
 
 // ----------------------------------------------------------------------------
-// stream
-std::istream& BigInt::operator>>(std::istream& stream_)
+// bits
+std::size_t BigInt::bit_length() const
 {
-	std::string str;
-	std::size_t st_p = 0U;
-	stream_ >> str;
-	if (str[0] == '-' || str[0] == '+')
-		st_p = 1U;
-	*this = read_big_int(str, st_p);
-	if (str[0] == '-')
-		b_is_neg = !is_zero();
-	return stream_;
+	if (is_zero())
+		return 0U;
+	return (b_num_vec.size() - 1U) * 32U + limb_bit_length(b_num_vec.back());
 }
 
-std::istream& operator>>(std::istream& stream_, BigInt& bi_)
+std::size_t BigInt::popcount() const
 {
-	return bi_.operator>>(stream_);
+	std::size_t res = 0U;
+	for (auto limb : b_num_vec)
+		for (; limb != 0U; limb &= limb - 1U) // clear lowest set bit
+			++res;
+	return res;
 }
 
-BigInt BigInt::read_big_int(const std::string& str_, std::size_t st_p_)
+std::size_t BigInt::count_trailing_zeros() const
 {
-	BigInt bi;
-	std::size_t last_digit_p = st_p_;
-	for (; last_digit_p < str_.length(); ++last_digit_p)
-		if (str_[last_digit_p] < '0' || str_[last_digit_p] > '9')
-			break;
-	if (st_p_ == last_digit_p)
-		return bi;
-	bi.b_num_vec.clear();
-	bi.b_num_vec.reserve(last_digit_p - st_p_ + 1U);
-	for (std::size_t i = st_p_; i < last_digit_p; ++i)
-		bi.b_num_vec.push_back(static_cast<std::int8_t>(str_[i] - '0')); // cp
-	bi = remove_leading_zeros(std::move(bi));
-	return bi;
+	for (std::size_t i = 0U; i < b_num_vec.size(); ++i)
+	{
+		if (b_num_vec[i] == 0U)
+			continue;
+		std::size_t res = i * 32U;
+		for (std::uint32_t limb = b_num_vec[i]; (limb & 1U) == 0U; limb >>= 1U)
+			++res;
+		return res;
+	}
+	return 0U;
 }
 
-std::ostream& BigInt::operator<<(std::ostream& stream_) const
+bool BigInt::test_bit(std::size_t pos_) const
 {
-	stream_ << to_string();
-	return stream_;
+	std::size_t limb_p = pos_ / 32U;
+	bool is_set = limb_p < b_num_vec.size() && ((b_num_vec[limb_p] >> (pos_ % 32U)) & 1U) != 0U;
+	if (!b_is_neg)
+		return is_set;
+	// -|val| = ~(|val| - 1): zeros up to the lowest set bit of |val|, then inverted bits
+	std::size_t am_tz = count_trailing_zeros();
+	if (pos_ <= am_tz)
+		return pos_ == am_tz;
+	return !is_set;
 }
 
-std::string BigInt::to_string() const
+const BigInt BigInt::operator~() const
 {
-	std::stringstream ss;
-	if (b_is_neg)
-		ss << "-";
-	for (const auto& val : b_num_vec)
-		ss << static_cast<std::int32_t>(val);
-	return ss.str();
+	return -(*this) - 1; // -val - 1
 }
 
-std::string BigInt::to_string_unsigned() const
+const BigInt BigInt::operator<<(std::size_t shift_) const
 {
-	std::stringstream ss;
-	for (const auto& val : b_num_vec)
-		ss << static_cast<std::int32_t>(val);
-	return ss.str();
+	BigInt res;
+	if (is_zero())
+		return res;
+	std::size_t limb_shift = shift_ / 32U;
+	std::size_t bit_shift = shift_ % 32U;
+	res.b_num_vec.assign(b_num_vec.size() + limb_shift + 1U, 0U);
+	for (std::size_t i = 0U; i < b_num_vec.size(); ++i)
+	{
+		res.b_num_vec[i + limb_shift] |= b_num_vec[i] << bit_shift;
+		if (bit_shift != 0U)
+			res.b_num_vec[i + limb_shift + 1U] = b_num_vec[i] >> (32U - bit_shift);
+	}
+	res = remove_leading_zeros(std::move(res));
+	res.b_is_neg = b_is_neg;
+	return res;
 }
 
-std::ostream& operator<<(std::ostream& stream_, const BigInt& bi_)
+const BigInt BigInt::operator>>(std::size_t shift_) const
 {
-	return bi_.operator<<(stream_);
+	// floor division by 2^shift_ (arithmetic shift)
+	std::size_t limb_shift = shift_ / 32U;
+	std::size_t bit_shift = shift_ % 32U;
+	if (limb_shift >= b_num_vec.size())
+		return (b_is_neg) ? BigInt(-1) : BigInt();
+	bool is_lost = false; // non-zero bits shifted out
+	for (std::size_t i = 0U; b_is_neg && !is_lost && i < limb_shift; ++i)
+		is_lost = b_num_vec[i] != 0U;
+	if (b_is_neg && bit_shift != 0U)
+		is_lost = is_lost || (b_num_vec[limb_shift] << (32U - bit_shift)) != 0U;
+	BigInt res;
+	res.b_num_vec.resize(b_num_vec.size() - limb_shift);
+	for (std::size_t i = 0U; i < res.b_num_vec.size(); ++i)
+	{
+		res.b_num_vec[i] = b_num_vec[i + limb_shift] >> bit_shift;
+		if (bit_shift != 0U && i + limb_shift + 1U < b_num_vec.size())
+			res.b_num_vec[i] |= b_num_vec[i + limb_shift + 1U] << (32U - bit_shift);
+	}
+	res = remove_leading_zeros(std::move(res));
+	if (is_lost)
+		simple_multiplication(res, 1U, 1U); // round toward -inf
+	res.b_is_neg = b_is_neg;
+	return res;
 }
 
-BigInt BigInt::to_big_int(std::int32_t val_)
+BigInt& BigInt::operator<<=(std::size_t shift_)
 {
-	BigInt bi;
-	auto str = std::to_string(val_);
-	to_big_int(bi, str);
-	return bi;
+	*this = this->operator<<(shift_);
+	return *this;
 }
 
-BigInt BigInt::to_big_int(std::size_t val_)
+BigInt& BigInt::operator>>=(std::size_t shift_)
 {
-	BigInt bi;
-	auto str = std::to_string(val_);
-	to_big_int(bi, str);
-	return bi;
+	*this = this->operator>>(shift_);
+	return *this;
 }
 
-BigInt BigInt::to_big_int(std::int64_t val_)
+const BigInt BigInt::operator&(std::int32_t r_val_) const
 {
-	BigInt bi;
-	auto str = std::to_string(val_);
-	to_big_int(bi, str);
-	return bi;
+	BigInt r_val = to_big_int(r_val_);
+	return operator&(r_val);
 }
 
-BigInt BigInt::to_big_int(std::uint64_t val_)
+#ifdef LEZ_SIZE_T_OVERLOADS
+const BigInt BigInt::operator&(std::size_t r_val_) const
 {
-	BigInt bi;
-	auto str = std::to_string(val_);
-	to_big_int(bi, str);
-	return bi;
+	BigInt r_val = to_big_int(r_val_);
+	return operator&(r_val);
 }
+#endif
 
-BigInt BigInt::to_big_int(const std::string& str_)
+const BigInt BigInt::operator&(std::int64_t r_val_) const
 {
-	BigInt bi;
-	to_big_int(bi, str_);
-	return bi;
+	BigInt r_val = to_big_int(r_val_);
+	return operator&(r_val);
 }
 
-void BigInt::to_big_int(BigInt& bi_, const std::string& str_) // without check
+const BigInt BigInt::operator&(std::uint64_t r_val_) const
 {
-	bi_.b_num_vec.clear();
-	if (str_.empty())
-	{
-		bi_ = BigInt();
-		return;
-	}
-	auto it = str_.cbegin();
-	std::size_t offset = 0U;
-	if (*it == '-')
-	{
-		bi_.b_is_neg = true; // direct
-		offset = 1U;
-		++it;
-	}
-	bi_.b_num_vec.reserve(str_.length() - offset);
-	while (it != str_.cend())
-	{
-		bi_.b_num_vec.push_back(*it - static_cast<std::int8_t>(48));
-		++it;
-	}
-	bi_ = remove_leading_zeros(bi_);
+	BigInt r_val = to_big_int(r_val_);
+	return operator&(r_val);
 }
 
-void BigInt::swap(BigInt& l_val_, BigInt& r_val_)
+const BigInt BigInt::operator&(const BigInt& r_val_) const
 {
-	using std::swap;
-	swap(l_val_.b_num_vec, r_val_.b_num_vec);
-	swap(l_val_.b_is_neg, r_val_.b_is_neg);
+	return bitwise_operation(*this, r_val_,
+		[](std::uint32_t l_limb_, std::uint32_t r_limb_) -> std::uint32_t { return l_limb_ & r_limb_; });
 }
 
-BigInt BigInt::append_leading_zeros(BigInt val_, std::size_t size_)
+const BigInt BigInt::operator|(std::int32_t r_val_) const
 {
-	while (val_.b_num_vec.size() < size_)
-		val_.b_num_vec.insert(val_.b_num_vec.begin(), static_cast<std::int8_t>(0));
-	return val_;
+	BigInt r_val = to_big_int(r_val_);
+	return operator|(r_val);
 }
 
-BigInt BigInt::remove_leading_zeros(BigInt val_)
+#ifdef LEZ_SIZE_T_OVERLOADS
+const BigInt BigInt::operator|(std::size_t r_val_) const
 {
-	while (val_.b_num_vec.size() > 1U && (*val_.b_num_vec.begin()) == static_cast<std::int8_t>(0))
-		val_.b_num_vec.erase(val_.b_num_vec.begin());
-	return val_;
+	BigInt r_val = to_big_int(r_val_);
+	return operator|(r_val);
 }
+#endif
 
+const BigInt BigInt::operator|(std::int64_t r_val_) const
+{
+	BigInt r_val = to_big_int(r_val_);
+	return operator|(r_val);
+}
 
-// ----------------------------------------------------------------------------
-// extra (use in BigReal)
-BigInt BigInt::addition_without_remove_leading_zeros(BigInt l_val_, BigInt r_val_)
-{
-	std::size_t gen_ap = (l_val_.amount_places() > r_val_.amount_places() ?
-		l_val_.amount_places() : r_val_.amount_places());
-	BigInt l_full_val = append_leading_zeros(std::move(l_val_), gen_ap);
-	BigInt r_full_val = append_leading_zeros(std::move(r_val_), gen_ap);
-	bool is_carry = false;
-	std::size_t r_i = gen_ap - 1U;
-	for (std::size_t i = 0U; i < gen_ap; ++i, --r_i)
-	{
-		if (is_carry)
-		{
-			++l_full_val.b_num_vec[r_i];
-			is_carry = false;
-		}
-		l_full_val.b_num_vec[r_i] += r_full_val.b_num_vec[r_i];
-		if (l_full_val.b_num_vec[r_i] >= static_cast<std::int8_t>(10))
-		{
-			l_full_val.b_num_vec[r_i] -= static_cast<std::int8_t>(10);
-			is_carry = true;
+const BigInt BigInt::operator|(std::uint64_t r_val_) const
+{
+	BigInt r_val = to_big_int(r_val_);
+	return operator|(r_val);
+}
+
+const BigInt BigInt::operator|(const BigInt& r_val_) const
+{
+	return bitwise_operation(*this, r_val_,
+		[](std::uint32_t l_limb_, std::uint32_t r_limb_) -> std::uint32_t { return l_limb_ | r_limb_; });
+}
+
+const BigInt BigInt::operator^(std::int32_t r_val_) const
+{
+	BigInt r_val = to_big_int(r_val_);
+	return operator^(r_val);
+}
+
+#ifdef LEZ_SIZE_T_OVERLOADS
+const BigInt BigInt::operator^(std::size_t r_val_) const
+{
+	BigInt r_val = to_big_int(r_val_);
+	return operator^(r_val);
+}
+#endif
+
+const BigInt BigInt::operator^(std::int64_t r_val_) const
+{
+	BigInt r_val = to_big_int(r_val_);
+	return operator^(r_val);
+}
+
+const BigInt BigInt::operator^(std::uint64_t r_val_) const
+{
+	BigInt r_val = to_big_int(r_val_);
+	return operator^(r_val);
+}
+
+const BigInt BigInt::operator^(const BigInt& r_val_) const
+{
+	return bitwise_operation(*this, r_val_,
+		[](std::uint32_t l_limb_, std::uint32_t r_limb_) -> std::uint32_t { return l_limb_ ^ r_limb_; });
+}
+
+BigInt& BigInt::operator&=(std::int32_t r_val_)
+{
+	*this = this->operator&(r_val_);
+	return *this;
+}
+
+#ifdef LEZ_SIZE_T_OVERLOADS
+BigInt& BigInt::operator&=(std::size_t r_val_)
+{
+	*this = this->operator&(r_val_);
+	return *this;
+}
+#endif
+
+BigInt& BigInt::operator&=(std::int64_t r_val_)
+{
+	*this = this->operator&(r_val_);
+	return *this;
+}
+
+BigInt& BigInt::operator&=(std::uint64_t r_val_)
+{
+	*this = this->operator&(r_val_);
+	return *this;
+}
+
+BigInt& BigInt::operator&=(const BigInt& r_val_)
+{
+	*this = this->operator&(r_val_);
+	return *this;
+}
+
+BigInt& BigInt::operator|=(std::int32_t r_val_)
+{
+	*this = this->operator|(r_val_);
+	return *this;
+}
+
+#ifdef LEZ_SIZE_T_OVERLOADS
+BigInt& BigInt::operator|=(std::size_t r_val_)
+{
+	*this = this->operator|(r_val_);
+	return *this;
+}
+#endif
+
+BigInt& BigInt::operator|=(std::int64_t r_val_)
+{
+	*this = this->operator|(r_val_);
+	return *this;
+}
+
+BigInt& BigInt::operator|=(std::uint64_t r_val_)
+{
+	*this = this->operator|(r_val_);
+	return *this;
+}
+
+BigInt& BigInt::operator|=(const BigInt& r_val_)
+{
+	*this = this->operator|(r_val_);
+	return *this;
+}
+
+BigInt& BigInt::operator^=(std::int32_t r_val_)
+{
+	*this = this->operator^(r_val_);
+	return *this;
+}
+
+#ifdef LEZ_SIZE_T_OVERLOADS
+BigInt& BigInt::operator^=(std::size_t r_val_)
+{
+	*this = this->operator^(r_val_);
+	return *this;
+}
+#endif
+
+BigInt& BigInt::operator^=(std::int64_t r_val_)
+{
+	*this = this->operator^(r_val_);
+	return *this;
+}
+
+BigInt& BigInt::operator^=(std::uint64_t r_val_)
+{
+	*this = this->operator^(r_val_);
+	return *this;
+}
+
+BigInt& BigInt::operator^=(const BigInt& r_val_)
+{
+	*this = this->operator^(r_val_);
+	return *this;
+}
+
+const BigInt operator&(std::int32_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator&(l_val_);
+}
+
+#ifdef LEZ_SIZE_T_OVERLOADS
+const BigInt operator&(std::size_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator&(l_val_);
+}
+#endif
+
+const BigInt operator&(std::int64_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator&(l_val_);
+}
+
+const BigInt operator&(std::uint64_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator&(l_val_);
+}
+
+const BigInt operator|(std::int32_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator|(l_val_);
+}
+
+#ifdef LEZ_SIZE_T_OVERLOADS
+const BigInt operator|(std::size_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator|(l_val_);
+}
+#endif
+
+const BigInt operator|(std::int64_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator|(l_val_);
+}
+
+const BigInt operator|(std::uint64_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator|(l_val_);
+}
+
+const BigInt operator^(std::int32_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator^(l_val_);
+}
+
+#ifdef LEZ_SIZE_T_OVERLOADS
+const BigInt operator^(std::size_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator^(l_val_);
+}
+#endif
+
+const BigInt operator^(std::int64_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator^(l_val_);
+}
+
+const BigInt operator^(std::uint64_t l_val_, const BigInt& r_val_)
+{
+	return r_val_.operator^(l_val_);
+}
+
+BigInt BigInt::bitwise_operation(const BigInt& l_val_, const BigInt& r_val_,
+	std::uint32_t (*op_)(std::uint32_t, std::uint32_t))
+{
+	// one extra limb keeps the sign bit
+	std::size_t size = std::max(l_val_.b_num_vec.size(), r_val_.b_num_vec.size()) + 1U;
+	std::vector<std::uint32_t> l_vec = to_twos_complement(l_val_, size);
+	std::vector<std::uint32_t> r_vec = to_twos_complement(r_val_, size);
+	for (std::size_t i = 0U; i < size; ++i)
+		l_vec[i] = op_(l_vec[i], r_vec[i]);
+	return from_twos_complement(std::move(l_vec));
+}
+
+std::vector<std::uint32_t> BigInt::to_twos_complement(const BigInt& val_, std::size_t size_)
+{
+	std::vector<std::uint32_t> vec(val_.b_num_vec);
+	vec.resize(size_, 0U);
+	if (!val_.b_is_neg)
+		return vec;
+	std::uint64_t carry = 1U; // ~mag + 1
+	for (auto& limb : vec)
+	{
+		carry += static_cast<std::uint32_t>(~limb);
+		limb = static_cast<std::uint32_t>(carry);
+		carry >>= 32U;
+	}
+	return vec;
+}
+
+BigInt BigInt::from_twos_complement(std::vector<std::uint32_t> vec_)
+{
+	BigInt res;
+	bool is_neg = !vec_.empty() && (vec_.back() >> 31U) != 0U;
+	if (is_neg)
+	{
+		std::uint64_t carry = 1U; // ~vec + 1
+		for (auto& limb : vec_)
+		{
+			carry += static_cast<std::uint32_t>(~limb);
+			limb = static_cast<std::uint32_t>(carry);
+			carry >>= 32U;
+		}
+	}
+	res.b_num_vec = std::move(vec_);
+	res = remove_leading_zeros(std::move(res));
+	res.b_is_neg = is_neg && !res.is_zero();
+	return res;
+}
+
+std::size_t BigInt::limb_bit_length(std::uint32_t limb_)
+{
+	std::size_t res = 0U;
+	for (; limb_ != 0U; limb_ >>= 1U)
+		++res;
+	return res;
+}
+
+
+// ----------------------------------------------------------------------------
+// stream
+std::istream& BigInt::operator>>(std::istream& stream_)
+{
+	BigIntParser parser; // no copy of the token
+	parser.read(stream_);
+	if (!parser.finish(*this))
+		reset();
+	return stream_;
+}
+
+std::istream& operator>>(std::istream& stream_, BigInt& bi_)
+{
+	return bi_.operator>>(stream_);
+}
+
+BigInt BigInt::read_big_int(const std::string& str_, std::size_t st_p_)
+{
+	BigInt bi;
+	if (st_p_ >= str_.length())
+		return bi;
+	const char* first = str_.data() + st_p_;
+	const char* last = Digits::skip_digits(first, str_.data() + str_.length());
+	if (first == last)
+		return bi;
+	read_digits(first, last, bi);
+	return bi;
+}
+
+void BigInt::read_digits(const char* first_, const char* last_, BigInt& val_)
+{
+	const std::size_t conversion_threshold = 4608U; // digits
+	std::size_t len = static_cast<std::size_t>(last_ - first_);
+	if (len <= conversion_threshold)
+	{
+		simple_read_digits(first_, last_, val_);
+		return;
+	}
+	// high * 10^(9 * 2^level) + low, the low part takes the last 9 * 2^level digits
+	std::size_t level = 0U;
+	while ((9U << (level + 1U)) < len)
+		++level;
+	const char* mid = last_ - (9U << level);
+	BigInt high, low;
+	parallel_for(2U, len / 9U, [&](std::size_t i_) { // long tokens: the halves at once
+		if (i_ == 0U)
+			read_digits(first_, mid, high);
+		else
+			read_digits(mid, last_, low);
+	});
+	val_ = addition(multiplication(high, *power_of_ten(level)), low);
+}
+
+void BigInt::simple_read_digits(const char* first_, const char* last_, BigInt& val_)
+{
+	std::size_t len = static_cast<std::size_t>(last_ - first_);
+	val_.b_num_vec.clear(); // keeps the capacity
+	val_.b_num_vec.reserve(len / 9U + 1U);
+	val_.b_is_neg = false;
+	// 9 digits per step, the first chunk takes the rest
+	std::size_t chunk_len = len % 9U;
+	if (chunk_len == 0U)
+		chunk_len = 9U;
+	const char* it = first_;
+	auto read_chunk = [&val_](const char* it_, std::size_t len_) {
+		std::uint32_t chunk = 0U;
+		std::uint32_t mul = 1U;
+		for (const char* dig = it_; dig < it_ + len_; ++dig)
+		{
+			chunk = chunk * 10U + static_cast<std::uint32_t>(*dig - '0');
+			mul *= 10U;
+		}
+		simple_multiplication(val_, mul, chunk);
+	};
+	if (it < last_)
+		read_chunk(it, chunk_len);
+	it += chunk_len;
+	// 72 digits = 9 octets (vectorized) = 8 chunks
+	std::uint32_t octets[9];
+	for (; last_ - it >= 72; it += 72)
+	{
+		Digits::parse_groups(it, 9U, octets);
+		const std::uint32_t chunks[8] = {
+			octets[0] * 10U + octets[1] / 10000000U,
+			octets[1] % 10000000U * 100U + octets[2] / 1000000U,
+			octets[2] % 1000000U * 1000U + octets[3] / 100000U,
+			octets[3] % 100000U * 10000U + octets[4] / 10000U,
+			octets[4] % 10000U * 100000U + octets[5] / 1000U,
+			octets[5] % 1000U * 1000000U + octets[6] / 100U,
+			octets[6] % 100U * 10000000U + octets[7] / 10U,
+			octets[7] % 10U * 100000000U + octets[8] };
+		for (auto chunk : chunks)
+			simple_multiplication(val_, 1000000000U, chunk);
+	}
+	for (; it < last_; it += 9)
+		read_chunk(it, 9U);
+}
+
+std::ostream& BigInt::operator<<(std::ostream& stream_) const
+{
+	// big values go out in chunks, padding needs the whole text
+	if (stream_.width() != 0 || b_num_vec.size() < 4096U)
+		return stream_ << to_string();
+	StreamWriter wr(stream_);
+	wr.write(*this);
+	return stream_;
+}
+
+std::string BigInt::to_string() const
+{
+	std::string str = to_string_unsigned();
+	if (b_is_neg)
+		str.insert(0U, 1U, '-');
+	return str;
+}
+
+std::string BigInt::to_string_unsigned() const
+{
+	std::string str;
+	str.reserve(b_num_vec.size() * 10U + 1U); // 32 bits < 10 digits
+	write_decimal(*this, [&str](const char* data_, std::size_t size_) {
+		str.append(data_, size_);
+		return true;
+	});
+	return str;
+}
+
+bool BigInt::write_decimal(const BigInt& val_, const std::function<bool(const char*, std::size_t)>& out_)
+{
+	if (!is_decimal_cacheable(val_))
+		return write_digits(val_, decimal_level(val_), false, out_);
+	// concurrent readers of one value may both convert, the last one stays
+	std::shared_ptr<const std::string> digs = std::atomic_load(&val_.b_dec_cache);
+	if (digs == nullptr)
+	{
+		auto str = std::make_shared<std::string>();
+		str->reserve(val_.b_num_vec.size() * 10U);
+		write_digits(val_, decimal_level(val_), false, [&str](const char* data_, std::size_t size_) {
+			str->append(data_, size_);
+			return true;
+		});
+		digs = std::move(str);
+		std::atomic_store(&val_.b_dec_cache, digs);
+	}
+	return out_(digs->data(), digs->length());
+}
+
+std::size_t BigInt::decimal_level(const BigInt& val_)
+{
+	// split by the cached 10^(9 * 2^level) with val < 10^(9 * 2^(level + 1))
+	std::size_t level = 0U;
+	while (2U * (power_of_ten(level)->b_num_vec.size() - 1U) < val_.b_num_vec.size())
+		++level;
+	return level + 1U;
+}
+
+std::size_t& BigInt::decimal_cache_limbs()
+{
+	static std::size_t decimal_cache_limbs = 0U;
+	return decimal_cache_limbs;
+}
+
+bool BigInt::is_decimal_cacheable(const BigInt& val_)
+{
+	std::size_t min_cached_limbs = decimal_cache_limbs();
+	return min_cached_limbs != 0U && val_.b_num_vec.size() >= min_cached_limbs;
+}
+
+std::size_t& BigInt::power_cache_limbs()
+{
+	static std::size_t power_cache_limbs = 1U << 20U;
+	return power_cache_limbs;
+}
+
+bool BigInt::write_digits(const BigInt& val_, std::size_t level_, bool is_padded_,
+	const std::function<bool(const char*, std::size_t)>& out_)
+{
+	const std::size_t conversion_threshold = 96U; // limbs
+	if (val_.b_num_vec.size() < conversion_threshold)
+	{
+		std::string part = simple_write_digits(val_, 10);
+		if (is_padded_)
+			part.insert(0U, (9U << level_) - part.length(), '0');
+		return out_(part.data(), part.length());
+	}
+	BigInt quot, rem;
+	division_by_power_of_ten(val_, level_ - 1U, quot, rem);
+	if (!is_padded_ && quot.is_zero()) // no leading zeros
+		return write_digits(rem, level_ - 1U, false, out_);
+	return write_digits(quot, level_ - 1U, is_padded_, out_) && write_digits(rem, level_ - 1U, true, out_);
+}
+
+std::string BigInt::simple_write_digits(const BigInt& val_, int base_)
+{
+	if (val_.is_zero())
+		return "0";
+	std::uint32_t chunk_base = 0U;
+	std::size_t chunk_len = chunk_length(base_, chunk_base);
+	// chunks of chunk_len digits, lowest first
+	BigInt cp_val(val_);
+	std::vector<std::uint32_t> chunks;
+	chunks.reserve(val_.b_num_vec.size() * 32U / 30U + 1U); // at least 30 bits per chunk
+	while (!cp_val.is_zero())
+		chunks.push_back(simple_division(cp_val, chunk_base));
+	std::string str(chunks.size() * chunk_len, '0');
+	if (base_ == 10) // leading digit + octet (vectorized) per chunk
+	{
+		std::size_t am = chunks.size();
+		std::vector<std::uint32_t> octets(am);
+		for (std::size_t i = 0U; i < am; ++i)
+			octets[i] = chunks[am - 1U - i] % 100000000U;
+		// octets go to the tail, then move left: the destination never passes the source
+		Digits::format_groups(octets.data(), am, &str[am]);
+		for (std::size_t i = 0U; i < am; ++i)
+		{
+			str[9U * i] = static_cast<char>('0' + chunks[am - 1U - i] / 100000000U);
+			std::memmove(&str[9U * i + 1U], &str[am + 8U * i], 8U);
+		}
+	}
+	else
+	{
+		char* it = &str[0] + str.length();
+		for (auto chunk : chunks)
+			for (std::size_t i = 0U; i < chunk_len; ++i, chunk /= static_cast<std::uint32_t>(base_))
+				*--it = digit_char(chunk % static_cast<std::uint32_t>(base_), base_);
+	}
+	str.erase(0U, str.find_first_not_of('0'));
+	return str;
+}
+
+struct BigInt::DecimalCache
+{
+	std::vector<std::shared_ptr<const BigInt>> powers; // by level, no gaps
+	std::vector<std::shared_ptr<const BigInt>> reciprocals; // of the normalized powers, null = not yet
+	std::mutex mutex;
+};
+
+BigInt::DecimalCache& BigInt::decimal_cache()
+{
+	static DecimalCache cache;
+	return cache;
+}
+
+void BigInt::clear_caches()
+{
+	// holders of a power or a reciprocal keep their own reference
+	DecimalCache& cache = decimal_cache();
+	std::lock_guard<std::mutex> lock(cache.mutex);
+	cache.powers = {};
+	cache.reciprocals = {};
+}
+
+std::shared_ptr<const BigInt> BigInt::power_of_ten(std::size_t level_)
+{
+	DecimalCache& cache = decimal_cache();
+	std::shared_ptr<const BigInt> power;
+	std::size_t level = 0U;
+	{
+		std::lock_guard<std::mutex> lock(cache.mutex);
+		if (cache.powers.empty())
+			cache.powers.push_back(std::make_shared<const BigInt>(to_big_int(1000000000)));
+		while (cache.powers.size() <= level_ && 2U * cache.powers.back()->b_num_vec.size() <= power_cache_limbs())
+			cache.powers.push_back(std::make_shared<const BigInt>(square(*cache.powers.back())));
+		level = std::min(level_, cache.powers.size() - 1U);
+		power = cache.powers[level];
+	}
+	// past the limit: squared on demand, not kept
+	for (; level < level_; ++level)
+		power = std::make_shared<const BigInt>(square(*power));
+	return power;
+}
+
+void BigInt::division_by_power_of_ten(const BigInt& val_, std::size_t level_, BigInt& quot_, BigInt& rem_)
+{
+	std::shared_ptr<const BigInt> power = power_of_ten(level_);
+	if (power->b_num_vec.size() < newton_threshold)
+	{
+		division_with_remainder(val_, *power, quot_, rem_);
+		return;
+	}
+	auto normalized_reciprocal = [&power]() {
+		return std::make_shared<const BigInt>(reciprocal(*power << (32U - limb_bit_length(power->b_num_vec.back()))));
+	};
+	std::shared_ptr<const BigInt> inv;
+	{
+		DecimalCache& cache = decimal_cache();
+		std::lock_guard<std::mutex> lock(cache.mutex);
+		if (level_ < cache.powers.size()) // a kept power keeps its reciprocal
+		{
+			if (cache.reciprocals.size() <= level_)
+				cache.reciprocals.resize(level_ + 1U);
+			if (cache.reciprocals[level_] == nullptr)
+				cache.reciprocals[level_] = normalized_reciprocal();
+			inv = cache.reciprocals[level_];
+		}
+	}
+	if (inv == nullptr)
+		inv = normalized_reciprocal();
+	newton_division(val_, *power, *inv, quot_, rem_);
+}
+
+std::ostream& operator<<(std::ostream& stream_, const BigInt& bi_)
+{
+	return bi_.operator<<(stream_);
+}
+
+std::to_chars_result to_chars(char* first_, char* last_, const BigInt& val_, int base_)
+{
+	if (base_ < 2 || base_ > 62)
+		return { last_, std::errc::invalid_argument };
+	std::size_t bits_per_dig = BigInt::power_of_two_bits(base_);
+	if (base_ != 10 && bits_per_dig == 0U) // divide and conquer in a temporary
+	{
+		std::string str = val_.to_string(base_);
+		if (static_cast<std::size_t>(last_ - first_) < str.length())
+			return { last_, std::errc::value_too_large };
+		std::memcpy(first_, str.data(), str.length());
+		return { first_ + str.length(), std::errc() };
+	}
+	char* it = first_;
+	if (val_.b_is_neg)
+	{
+		if (it == last_)
+			return { last_, std::errc::value_too_large };
+		*it++ = '-';
+	}
+	if (bits_per_dig != 0U)
+	{
+		std::size_t am_dig = std::max<std::size_t>((val_.bit_length() + bits_per_dig - 1U) / bits_per_dig, 1U);
+		if (static_cast<std::size_t>(last_ - it) < am_dig)
+			return { last_, std::errc::value_too_large };
+		BigInt::write_power_of_two_digits(val_, base_, it, it + am_dig);
+		return { it + am_dig, std::errc() };
+	}
+	const std::vector<std::uint32_t>& vec = val_.b_num_vec;
+	if (vec.size() <= 2U) // fits in 64 bits
+	{
+		std::uint64_t mag = 0U;
+		for (std::size_t i = vec.size(); i-- != 0U;)
+			mag = (mag << 32U) | vec[i];
+		return std::to_chars(it, last_, mag);
+	}
+	const std::size_t max_stack_limbs = 64U;
+	if (vec.size() > max_stack_limbs) // divide and conquer in a temporary
+	{
+		std::string str = val_.to_string_unsigned();
+		if (static_cast<std::size_t>(last_ - it) < str.length())
+			return { last_, std::errc::value_too_large };
+		std::memcpy(it, str.data(), str.length());
+		return { it + str.length(), std::errc() };
+	}
+	// chunks of 9 digits from the right, on the stack
+	std::uint32_t limbs[max_stack_limbs];
+	std::copy(vec.begin(), vec.end(), limbs);
+	std::size_t am_limbs = vec.size();
+	char digits[max_stack_limbs * 10U];
+	char* dig_end = digits + sizeof(digits);
+	char* dig_it = dig_end;
+	while (am_limbs != 0U)
+	{
+		std::uint64_t rem = 0U;
+		for (std::size_t i = am_limbs; i-- != 0U;)
+		{
+			rem = (rem << 32U) | limbs[i];
+			limbs[i] = static_cast<std::uint32_t>(rem / 1000000000U);
+			rem %= 1000000000U;
+		}
+		while (am_limbs != 0U && limbs[am_limbs - 1U] == 0U)
+			--am_limbs;
+		for (std::size_t i = 0U; i < 9U; ++i, rem /= 10U)
+			*--dig_it = static_cast<char>('0' + rem % 10U);
+	}
+	while (*dig_it == '0') // nonzero here
+		++dig_it;
+	std::size_t len = static_cast<std::size_t>(dig_end - dig_it);
+	if (static_cast<std::size_t>(last_ - it) < len)
+		return { last_, std::errc::value_too_large };
+	std::memcpy(it, dig_it, len);
+	return { it + len, std::errc() };
+}
+
+std::from_chars_result from_chars(const char* first_, const char* last_, BigInt& val_, int base_)
+{
+	if (base_ < 2 || base_ > 62)
+		return { first_, std::errc::invalid_argument };
+	const char* it = first_;
+	bool is_neg = (it != last_ && *it == '-');
+	if (is_neg)
+		++it;
+	const char* digits = it;
+	if (base_ == 10)
+		it = Digits::skip_digits(it, last_);
+	while (it != last_ && BigInt::digit_value(*it, base_) < static_cast<std::uint32_t>(base_))
+		++it;
+	if (it == digits)
+		return { first_, std::errc::invalid_argument };
+	BigInt::read_digits(digits, it, base_, val_); // reuses the limbs of val_
+	val_.b_dec_cache.reset();
+	val_.b_is_neg = is_neg && !val_.is_zero();
+	return { it, std::errc() };
+}
+
+BigInt BigInt::to_big_int(std::int32_t val_)
+{
+	std::uint64_t mag = static_cast<std::uint64_t>(val_);
+	if (val_ < 0)
+		mag = 0U - mag; // works for min too
+	return to_big_int_from_magnitude(mag, val_ < 0);
+}
+
+#ifdef LEZ_SIZE_T_OVERLOADS
+BigInt BigInt::to_big_int(std::size_t val_)
+{
+	return to_big_int_from_magnitude(static_cast<std::uint64_t>(val_), false);
+}
+#endif
+
+BigInt BigInt::to_big_int(std::int64_t val_)
+{
+	std::uint64_t mag = static_cast<std::uint64_t>(val_);
+	if (val_ < 0)
+		mag = 0U - mag; // works for min too
+	return to_big_int_from_magnitude(mag, val_ < 0);
+}
+
+BigInt BigInt::to_big_int(std::uint64_t val_)
+{
+	return to_big_int_from_magnitude(static_cast<std::uint64_t>(val_), false);
+}
+
+BigInt BigInt::to_big_int(const std::string& str_)
+{
+	BigInt bi;
+	to_big_int(bi, str_);
+	return bi;
+}
+
+BigInt BigInt::to_big_int_from_magnitude(std::uint64_t mag_, bool is_neg_)
+{
+	BigInt bi;
+	if (mag_ == 0U)
+		return bi;
+	bi.b_num_vec.push_back(static_cast<std::uint32_t>(mag_));
+	if ((mag_ >> 32U) != 0U)
+		bi.b_num_vec.push_back(static_cast<std::uint32_t>(mag_ >> 32U));
+	bi.b_is_neg = is_neg_;
+	return bi;
+}
+
+void BigInt::to_big_int(BigInt& bi_, const std::string& str_) // without check
+{
+	if (str_.empty())
+	{
+		bi_ = BigInt();
+		return;
+	}
+	std::size_t offset = (str_.front() == '-') ? 1U : 0U;
+	bi_ = read_big_int(str_, offset); // up to the first non-digit
+	if (offset != 0U)
+		bi_.set_neg();
+}
+
+void BigInt::swap(BigInt& l_val_, BigInt& r_val_)
+{
+	using std::swap;
+	swap(l_val_.b_num_vec, r_val_.b_num_vec);
+	swap(l_val_.b_is_neg, r_val_.b_is_neg);
+	swap(l_val_.b_dec_cache, r_val_.b_dec_cache);
+}
+
+BigInt BigInt::remove_leading_zeros(BigInt val_)
+{
+	while (!val_.b_num_vec.empty() && val_.b_num_vec.back() == 0U)
+		val_.b_num_vec.pop_back();
+	if (val_.b_num_vec.empty())
+		val_.b_is_neg = false;
+	return val_;
+}
+
+
+// ----------------------------------------------------------------------------
+// bytes
+std::size_t BigInt::byte_length(Signedness sign_) const
+{
+	std::size_t bits = bit_length();
+	if (sign_ == Signedness::twos_complement)
+	{
+		// -2^k fits into k + 1 bits, everything else needs a sign bit on top
+		if (!b_is_neg || popcount() != 1U)
+			++bits;
+	}
+	return bits == 0U ? 1U : (bits + 7U) / 8U;
+}
+
+std::vector<std::uint8_t> BigInt::to_bytes(Endian endian_, Signedness sign_) const
+{
+	std::vector<std::uint8_t> vec(byte_length(sign_));
+	export_to(vec.data(), vec.size(), endian_, sign_);
+	return vec;
+}
+
+bool BigInt::export_to(std::uint8_t* data_, std::size_t size_, Endian endian_, Signedness sign_) const
+{
+	if (size_ < byte_length(sign_))
+		return false;
+	bool is_negated = b_is_neg && sign_ == Signedness::twos_complement;
+	std::uint32_t carry = 1U; // ~mag + 1
+	for (std::size_t i = 0U; i < size_; ++i)
+	{
+		std::uint32_t byte = 0U;
+		if (i / 4U < b_num_vec.size())
+			byte = (b_num_vec[i / 4U] >> (8U * (i % 4U))) & 0xFFU;
+		if (is_negated)
+		{
+			byte = (~byte & 0xFFU) + carry;
+			carry = byte >> 8U;
+		}
+		data_[endian_ == Endian::little ? i : size_ - 1U - i] = static_cast<std::uint8_t>(byte);
+	}
+	return true;
+}
+
+std::size_t BigInt::ordered_key_size() const
+{
+	if (is_zero())
+		return 1U;
+	std::size_t size = byte_length();
+	std::size_t am_len_bytes = 0U;
+	for (std::size_t len = size; len != 0U; len >>= 8U)
+		++am_len_bytes;
+	return 1U + am_len_bytes + size;
+}
+
+std::vector<std::uint8_t> BigInt::to_ordered_key() const
+{
+	std::vector<std::uint8_t> vec(ordered_key_size());
+	to_ordered_key(vec.data());
+	return vec;
+}
+
+std::uint8_t* BigInt::to_ordered_key(std::uint8_t* data_) const
+{
+	if (is_zero())
+	{
+		*data_ = 0x80U;
+		return data_ + 1U;
+	}
+	std::size_t size = byte_length();
+	std::size_t am_len_bytes = 0U;
+	for (std::size_t len = size; len != 0U; len >>= 8U)
+		++am_len_bytes;
+	// a longer length, then a longer magnitude, then a bigger magnitude is a bigger number
+	std::uint8_t* cur = data_;
+	*cur++ = static_cast<std::uint8_t>(b_is_neg ? 0x80U - am_len_bytes : 0x80U + am_len_bytes);
+	for (std::size_t i = am_len_bytes; i-- != 0U; )
+		*cur++ = static_cast<std::uint8_t>(size >> (8U * i));
+	export_to(cur, size, Endian::big);
+	cur += size;
+	if (b_is_neg) // inverted: a bigger magnitude is a smaller number
+	{
+		for (std::uint8_t* ptr = data_ + 1U; ptr != cur; ++ptr)
+			*ptr = static_cast<std::uint8_t>(~*ptr);
+	}
+	return cur;
+}
+
+const std::uint8_t* BigInt::from_ordered_key(const std::uint8_t* first_, const std::uint8_t* last_, BigInt& val_)
+{
+	if (first_ == last_)
+		return nullptr;
+	std::uint8_t tag = *first_++;
+	if (tag == 0x80U)
+	{
+		val_.reset();
+		return first_;
+	}
+	bool is_neg = tag < 0x80U;
+	std::size_t am_len_bytes = is_neg ? 0x80U - tag : tag - 0x80U;
+	std::uint8_t mask = is_neg ? 0xFFU : 0x00U;
+	if (am_len_bytes > sizeof(std::size_t) || static_cast<std::size_t>(last_ - first_) < am_len_bytes)
+		return nullptr;
+	std::size_t size = 0U;
+	for (std::size_t i = 0U; i < am_len_bytes; ++i)
+		size = size << 8U | static_cast<std::uint8_t>(first_[i] ^ mask);
+	first_ += am_len_bytes;
+	// canonical only: no leading zero bytes in the length or the magnitude
+	if ((first_[-static_cast<std::ptrdiff_t>(am_len_bytes)] ^ mask) == 0U ||
+		static_cast<std::size_t>(last_ - first_) < size || (first_[0] ^ mask) == 0U)
+		return nullptr;
+	if (is_neg)
+	{
+		std::vector<std::uint8_t> vec(first_, first_ + size);
+		for (auto& byte : vec)
+			byte = static_cast<std::uint8_t>(~byte);
+		val_ = from_bytes(vec.data(), size, Endian::big);
+		val_.b_is_neg = true;
+	}
+	else
+		val_ = from_bytes(first_, size, Endian::big);
+	return first_ + size;
+}
+
+BigInt BigInt::from_bytes(const std::uint8_t* data_, std::size_t size_, Endian endian_, Signedness sign_)
+{
+	std::vector<std::uint32_t> vec((size_ + 3U) / 4U, 0U);
+	for (std::size_t i = 0U; i < size_; ++i)
+	{
+		std::uint32_t byte = data_[endian_ == Endian::little ? i : size_ - 1U - i];
+		vec[i / 4U] |= byte << (8U * (i % 4U));
+	}
+	BigInt res;
+	if (sign_ == Signedness::twos_complement && size_ != 0U)
+	{
+		std::uint8_t top = data_[endian_ == Endian::little ? size_ - 1U : 0U];
+		if ((top >> 7U) != 0U) // sign extension up to the full limb
+		{
+			for (std::size_t i = size_; i < vec.size() * 4U; ++i)
+				vec[i / 4U] |= 0xFFU << (8U * (i % 4U));
+		}
+		return from_twos_complement(std::move(vec));
+	}
+	res.b_num_vec = std::move(vec);
+	return remove_leading_zeros(std::move(res));
+}
+
+
+// ----------------------------------------------------------------------------
+// bases
+std::string BigInt::to_string(int base_) const
+{
+	if (base_ == 10)
+		return to_string();
+	std::string str;
+	if (base_ < 2 || base_ > 62) // unknown base
+		return str;
+	if (b_is_neg)
+		str += '-';
+	std::size_t bits_per_dig = power_of_two_bits(base_);
+	if (bits_per_dig != 0U) // straight from the limbs
+	{
+		std::size_t am_dig = std::max<std::size_t>((bit_length() + bits_per_dig - 1U) / bits_per_dig, 1U);
+		str.resize(str.length() + am_dig);
+		write_power_of_two_digits(*this, base_, &str[0] + str.length() - am_dig, &str[0] + str.length());
+		return str;
+	}
+	const std::size_t conversion_threshold = 96U; // limbs
+	if (b_num_vec.size() < conversion_threshold)
+		return str + simple_write_digits(*this, base_);
+	// divide and conquer by chunk_base^(2^level), chunk_base = base_^chunk_len
+	std::uint32_t chunk_base = 0U;
+	chunk_length(base_, chunk_base);
+	std::vector<BigInt> powers(1U, to_big_int(static_cast<std::uint64_t>(chunk_base)));
+	while (2U * (powers.back().b_num_vec.size() - 1U) < b_num_vec.size())
+		powers.push_back(square(powers.back()));
+	write_digits(*this, base_, powers, powers.size(), false, str);
+	return str;
+}
+
+BigInt BigInt::to_big_int(const std::string& str_, int base_)
+{
+	BigInt bi;
+	from_chars(str_.data(), str_.data() + str_.length(), bi, base_); // zero if no digits
+	return bi;
+}
+
+void BigInt::write_digits(const BigInt& val_, int base_, const std::vector<BigInt>& powers_, std::size_t level_,
+	bool is_padded_, std::string& str_)
+{
+	const std::size_t conversion_threshold = 96U; // limbs
+	if (val_.b_num_vec.size() < conversion_threshold)
+	{
+		std::uint32_t chunk_base = 0U;
+		std::string part = simple_write_digits(val_, base_);
+		if (is_padded_)
+			str_.append((chunk_length(base_, chunk_base) << level_) - part.length(), '0');
+		str_ += part;
+		return;
+	}
+	BigInt quot, rem;
+	division_with_remainder(val_, powers_[level_ - 1U], quot, rem);
+	if (!is_padded_ && quot.is_zero()) // no leading zeros
+	{
+		write_digits(rem, base_, powers_, level_ - 1U, false, str_);
+		return;
+	}
+	write_digits(quot, base_, powers_, level_ - 1U, is_padded_, str_);
+	write_digits(rem, base_, powers_, level_ - 1U, true, str_);
+}
+
+void BigInt::write_power_of_two_digits(const BigInt& val_, int base_, char* first_, char* last_)
+{
+	// the lowest (last_ - first_) digits, k bits each
+	const std::vector<std::uint32_t>& vec = val_.b_num_vec;
+	std::size_t bits_per_dig = power_of_two_bits(base_);
+	std::uint32_t mask = (1U << bits_per_dig) - 1U;
+	std::size_t pos = 0U;
+	for (char* it = last_; it != first_; pos += bits_per_dig)
+	{
+		std::size_t limb = pos / 32U;
+		std::uint64_t word = (limb < vec.size()) ? vec[limb] : 0U;
+		if (limb + 1U < vec.size())
+			word |= static_cast<std::uint64_t>(vec[limb + 1U]) << 32U;
+		*--it = digit_char(static_cast<std::uint32_t>(word >> (pos % 32U)) & mask, base_);
+	}
+}
+
+void BigInt::read_digits(const char* first_, const char* last_, int base_, BigInt& val_)
+{
+	if (base_ == 10)
+	{
+		read_digits(first_, last_, val_);
+		return;
+	}
+	if (power_of_two_bits(base_) != 0U)
+	{
+		read_power_of_two_digits(first_, last_, base_, val_);
+		return;
+	}
+	std::uint32_t chunk_base = 0U;
+	std::size_t chunk_len = chunk_length(base_, chunk_base);
+	std::size_t len = static_cast<std::size_t>(last_ - first_);
+	std::vector<BigInt> powers(1U, to_big_int(static_cast<std::uint64_t>(chunk_base)));
+	while ((chunk_len << powers.size()) < len)
+		powers.push_back(square(powers.back()));
+	read_digits(first_, last_, base_, powers, val_);
+}
+
+void BigInt::read_digits(const char* first_, const char* last_, int base_, const std::vector<BigInt>& powers_,
+	BigInt& val_)
+{
+	const std::size_t conversion_threshold = 512U; // chunks
+	std::uint32_t chunk_base = 0U;
+	std::size_t chunk_len = chunk_length(base_, chunk_base);
+	std::size_t len = static_cast<std::size_t>(last_ - first_);
+	if (len <= chunk_len * conversion_threshold)
+	{
+		simple_read_digits(first_, last_, base_, val_);
+		return;
+	}
+	// high * powers_[level] + low, the low part takes the last chunk_len * 2^level digits
+	std::size_t level = 0U;
+	while ((chunk_len << (level + 1U)) < len)
+		++level;
+	const char* mid = last_ - (chunk_len << level);
+	BigInt high, low;
+	parallel_for(2U, len / chunk_len, [&](std::size_t i_) {
+		if (i_ == 0U)
+			read_digits(first_, mid, base_, powers_, high);
+		else
+			read_digits(mid, last_, base_, powers_, low);
+	});
+	val_ = addition(multiplication(high, powers_[level]), low);
+}
+
+void BigInt::simple_read_digits(const char* first_, const char* last_, int base_, BigInt& val_)
+{
+	std::uint32_t chunk_base = 0U;
+	std::size_t chunk_len = chunk_length(base_, chunk_base);
+	std::size_t len = static_cast<std::size_t>(last_ - first_);
+	val_.b_num_vec.clear(); // keeps the capacity
+	val_.b_num_vec.reserve(len / chunk_len + 1U);
+	val_.b_is_neg = false;
+	std::size_t first_len = len % chunk_len;
+	if (first_len == 0U)
+		first_len = chunk_len;
+	for (const char* it = first_; it < last_; it += first_len, first_len = chunk_len)
+	{
+		std::uint32_t chunk = 0U;
+		std::uint32_t mul = 1U;
+		for (const char* dig = it; dig < it + first_len; ++dig)
+		{
+			chunk = chunk * static_cast<std::uint32_t>(base_) + digit_value(*dig, base_);
+			mul *= static_cast<std::uint32_t>(base_);
+		}
+		simple_multiplication(val_, mul, chunk);
+	}
+}
+
+void BigInt::read_power_of_two_digits(const char* first_, const char* last_, int base_, BigInt& val_)
+{
+	std::size_t bits_per_dig = power_of_two_bits(base_);
+	std::size_t len = static_cast<std::size_t>(last_ - first_);
+	val_.b_num_vec.assign((len * bits_per_dig + 31U) / 32U, 0U);
+	val_.b_is_neg = false;
+	std::size_t pos = 0U;
+	for (const char* it = last_; it != first_; pos += bits_per_dig)
+	{
+		std::uint32_t dig = digit_value(*--it, base_);
+		std::size_t limb = pos / 32U;
+		std::size_t offset = pos % 32U;
+		val_.b_num_vec[limb] |= dig << offset;
+		if (offset + bits_per_dig > 32U)
+			val_.b_num_vec[limb + 1U] |= dig >> (32U - offset);
+	}
+	val_ = remove_leading_zeros(std::move(val_));
+}
+
+std::size_t BigInt::power_of_two_bits(int base_)
+{
+	std::size_t bits = 0U;
+	for (int val = base_; val > 1 && (val & 1) == 0; val >>= 1)
+		++bits;
+	return ((1 << bits) == base_) ? bits : 0U;
+}
+
+std::size_t BigInt::chunk_length(int base_, std::uint32_t& chunk_base_)
+{
+	std::size_t len = 0U;
+	std::uint64_t power = 1U;
+	for (; power * static_cast<std::uint64_t>(base_) <= 0xFFFFFFFFU; ++len)
+		power *= static_cast<std::uint64_t>(base_);
+	chunk_base_ = static_cast<std::uint32_t>(power);
+	return len;
+}
+
+std::uint32_t BigInt::digit_value(char ch_, int base_)
+{
+	// >= base_ if not a digit; letters ignore case up to base 36
+	if (ch_ >= '0' && ch_ <= '9')
+		return static_cast<std::uint32_t>(ch_ - '0');
+	if (ch_ >= 'A' && ch_ <= 'Z')
+		return static_cast<std::uint32_t>(ch_ - 'A') + 10U;
+	if (ch_ >= 'a' && ch_ <= 'z')
+		return static_cast<std::uint32_t>(ch_ - 'a') + ((base_ > 36) ? 36U : 10U);
+	return 62U;
+}
+
+char BigInt::digit_char(std::uint32_t dig_, int base_)
+{
+	const char* digits = (base_ > 36) ?
+		"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz" :
+		"0123456789abcdefghijklmnopqrstuvwxyz";
+	return digits[dig_];
+}
+
+
+// ----------------------------------------------------------------------------
+// batch
+std::vector<BigInt> BigInt::remainders(const BigInt& val_, const std::vector<BigInt>& moduli_)
+{
+	if (moduli_.empty())
+		return std::vector<BigInt>();
+	return remainder_tree(val_, product_tree(remainder_leaves(moduli_)));
+}
+
+std::vector<std::vector<BigInt>> BigInt::remainders(const std::vector<BigInt>& vals_,
+	const std::vector<BigInt>& moduli_)
+{
+	std::vector<std::vector<BigInt>> res(vals_.size());
+	if (moduli_.empty())
+		return res;
+	std::vector<std::vector<BigInt>> tree = product_tree(remainder_leaves(moduli_));
+	for (std::size_t j = 0U; j < vals_.size(); ++j)
+		res[j] = remainder_tree(vals_[j], tree);
+	return res;
+}
+
+std::vector<BigInt> BigInt::remainder_leaves(const std::vector<BigInt>& moduli_)
+{
+	std::vector<BigInt> leaves;
+	leaves.reserve(moduli_.size());
+	for (const auto& val : moduli_)
+	{
+		BigInt leaf(val);
+		leaf.b_is_neg = false;
+		if (leaf.is_zero()) // remainder of division by zero is zero, x % 1 too
+			leaf = BigInt(1);
+		leaves.push_back(std::move(leaf));
+	}
+	return leaves;
+}
+
+std::vector<BigInt> BigInt::remainder_tree(const BigInt& val_, const std::vector<std::vector<BigInt>>& tree_)
+{
+	BigInt cp_val(val_);
+	cp_val.b_is_neg = false;
+	std::vector<BigInt> rems(1U, cp_val % tree_.back().front());
+	for (std::size_t lvl = tree_.size() - 1U; lvl != 0U; --lvl)
+	{
+		const std::vector<BigInt>& nodes = tree_[lvl - 1U];
+		std::vector<BigInt> next_rems(nodes.size());
+		parallel_for(nodes.size(), amount_limbs(rems), [&](std::size_t i) {
+			next_rems[i] = rems[i / 2U] % nodes[i]; // parent of i is i / 2
+		});
+		rems = std::move(next_rems);
+	}
+	if (val_.b_is_neg) // sign as in operator%
+		for (auto& val : rems)
+			val.set_neg();
+	return rems;
+}
+
+std::vector<std::vector<BigInt>> BigInt::product_tree(const std::vector<BigInt>& leaves_)
+{
+	std::vector<std::vector<BigInt>> tree(1U, leaves_);
+	while (tree.back().size() > 1U)
+	{
+		const std::vector<BigInt>& nodes = tree.back();
+		std::vector<BigInt> parents((nodes.size() + 1U) / 2U);
+		parallel_for(nodes.size() / 2U, amount_limbs(nodes), [&](std::size_t i) {
+			parents[i] = nodes[2U * i] * nodes[2U * i + 1U];
+		});
+		if (nodes.size() % 2U != 0U) // odd node goes up as is
+			parents.back() = nodes.back();
+		tree.push_back(std::move(parents));
+	}
+	return tree;
+}
+
+std::vector<BigInt> BigInt::batch_gcd(const std::vector<BigInt>& moduli_)
+{
+	std::vector<BigInt> res(moduli_.size());
+	std::vector<BigInt> leaves;
+	std::vector<std::size_t> leaf_pos;
+	leaves.reserve(moduli_.size());
+	leaf_pos.reserve(moduli_.size());
+	for (std::size_t i = 0U; i < moduli_.size(); ++i)
+	{
+		if (moduli_[i].is_zero()) // gcd(x, 0) = x, kept out of the tree
+			continue;
+		BigInt leaf(moduli_[i]);
+		leaf.b_is_neg = false;
+		leaves.push_back(std::move(leaf));
+		leaf_pos.push_back(i);
+	}
+	std::size_t am_zeros = moduli_.size() - leaves.size();
+	std::vector<std::vector<BigInt>> tree;
+	if (am_zeros < 2U && !leaves.empty())
+		tree = product_tree(leaves);
+	if (am_zeros != 0U)
+	{
+		// others contain zero: gcd is the value itself; a single zero gets the product of the others,
+		// the root of the tree (gcd(0, 1) = 1 if there are none), more zeros get gcd(0, 0) = 0
+		for (std::size_t i = 0U; i < leaves.size(); ++i)
+			res[leaf_pos[i]] = leaves[i];
+		if (am_zeros == 1U)
+			for (std::size_t i = 0U; i < moduli_.size(); ++i)
+				if (moduli_[i].is_zero())
+					res[i] = tree.empty() ? BigInt(1) : tree.back().front();
+		return res;
+	}
+	if (leaves.empty())
+		return res;
+	// P mod N^2 down the tree of squares, then gcd((P mod N^2) / N, N)
+	std::vector<BigInt> rems(1U, tree.back().front());
+	for (std::size_t lvl = tree.size() - 1U; lvl != 0U; --lvl)
+	{
+		const std::vector<BigInt>& nodes = tree[lvl - 1U];
+		std::vector<BigInt> next_rems(nodes.size());
+		parallel_for(nodes.size(), amount_limbs(rems), [&](std::size_t i) {
+			next_rems[i] = rems[i / 2U] % (nodes[i] * nodes[i]);
+		});
+		rems = std::move(next_rems);
+	}
+	parallel_for(leaves.size(), amount_limbs(rems), [&](std::size_t i) {
+		res[leaf_pos[i]] = gcd(rems[i] / leaves[i], leaves[i]);
+	});
+	return res;
+}
+
+BigInt BigInt::gcd(BigInt l_val_, BigInt r_val_)
+{
+	l_val_.b_is_neg = false;
+	r_val_.b_is_neg = false;
+	while (!r_val_.is_zero())
+	{
+		l_val_ %= r_val_;
+		swap(l_val_, r_val_);
+	}
+	return l_val_;
+}
+
+void BigInt::parallel_for(std::size_t am_, std::size_t am_limbs_, const std::function<void(std::size_t)>& fn_)
+{
+	thread_local bool is_worker = false; // a tree level multiplies, a multiplication may be parallel too
+	std::size_t am_threads = std::min<std::size_t>(std::thread::hardware_concurrency(), am_);
+	if (am_threads < 2U || am_limbs_ < parallel_limbs || is_worker)
+	{
+		for (std::size_t i = 0U; i < am_; ++i)
+			fn_(i);
+		return;
+	}
+	std::exception_ptr error;
+	std::mutex error_mutex;
+	auto work = [&fn_, &error, &error_mutex, am_, am_threads](std::size_t t_) {
+		is_worker = true;
+		try
+		{
+			for (std::size_t i = t_; i < am_; i += am_threads) // interleaved, nodes of a level differ in size
+				fn_(i);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(error_mutex);
+			if (!error)
+				error = std::current_exception();
+		}
+		is_worker = false;
+	};
+	std::vector<std::thread> threads;
+	threads.reserve(am_threads - 1U);
+	for (std::size_t t = 1U; t < am_threads; ++t)
+	{
+		try
+		{
+			threads.emplace_back(work, t);
+		}
+		catch (const std::system_error&)
+		{
+			work(t); // no thread to be had: this share here
+		}
+	}
+	work(0U);
+	for (auto& thread : threads)
+		thread.join();
+	if (error)
+		std::rethrow_exception(error);
+}
+
+std::size_t BigInt::amount_limbs(const std::vector<BigInt>& vals_)
+{
+	std::size_t res = 0U;
+	for (const auto& val : vals_)
+		res += val.b_num_vec.size();
+	return res;
+}
+
+
+// ----------------------------------------------------------------------------
+// sequences
+BigInt BigInt::fibonacci(std::uint64_t n_)
+{
+	BigInt fn, fn_1;
+	fibonacci_pair(n_, fn, fn_1);
+	return fn;
+}
+
+BigInt BigInt::lucas(std::uint64_t n_)
+{
+	// L(n) = F(n + 1) + F(n - 1) = F(n) + 2 * F(n - 1)
+	BigInt fn, fn_1;
+	fibonacci_pair(n_, fn, fn_1);
+	return addition(fn, fn_1 << 1U);
+}
+
+void BigInt::fibonacci_pair(std::uint64_t n_, BigInt& fn_, BigInt& fn_1_)
+{
+	fn_ = BigInt(); // F(0)
+	fn_1_ = BigInt(1); // F(-1)
+	if (n_ == 0U)
+		return;
+	std::size_t pos = 63U;
+	while (((n_ >> pos) & 1U) == 0U)
+		--pos;
+	// k = 1, then k = 2k or 2k + 1 per bit; two squarings per step:
+	// F(2k + 1) = 4 F(k)^2 - F(k - 1)^2 + 2 (-1)^k, F(2k - 1) = F(k)^2 + F(k - 1)^2
+	fn_ = BigInt(1);
+	fn_1_ = BigInt();
+	bool is_k_odd = true;
+	while (pos-- != 0U)
+	{
+		BigInt fk_sq = square(fn_);
+		BigInt fk_1_sq = square(fn_1_);
+		BigInt f2k_1 = addition(fk_sq, fk_1_sq); // F(2k - 1)
+		BigInt f2k1 = (fk_sq << 2U) - fk_1_sq; // F(2k + 1)
+		f2k1 += (is_k_odd) ? -2 : 2;
+		BigInt f2k = subtraction(f2k1, f2k_1); // F(2k)
+		bool is_bit = ((n_ >> pos) & 1U) != 0U;
+		if (is_bit)
+		{
+			fn_ = std::move(f2k1);
+			fn_1_ = std::move(f2k);
+		}
+		else
+		{
+			fn_ = std::move(f2k);
+			fn_1_ = std::move(f2k_1);
 		}
+		is_k_odd = is_bit;
 	}
-	if (is_carry)
-		l_full_val.b_num_vec.insert(l_full_val.b_num_vec.begin(), static_cast<std::int8_t>(1));
-	return l_full_val;
 }
 
-BigInt BigInt::subtraction_without_remove_leading_zeros(BigInt l_val_, BigInt r_val_)
+BigInt BigInt::linear_recurrence(const std::vector<BigInt>& coefs_, const std::vector<BigInt>& init_,
+	std::uint64_t n_)
 {
-	std::size_t gen_ap = (l_val_.amount_places() > r_val_.amount_places() ?
-		l_val_.amount_places() : r_val_.amount_places());
-	BigInt l_full_val = append_leading_zeros(std::move(l_val_), gen_ap);
-	BigInt r_full_val = append_leading_zeros(std::move(r_val_), gen_ap);
-	bool is_carry = false;
-	std::size_t r_i = gen_ap - 1U;
-	for (std::size_t i = 0U; i < gen_ap; ++i, --r_i)
+	// Fiduccia: x^n mod (x^k - c_0 x^(k-1) - ... - c_k-1), then a(n) = sum r_i a(i)
+	std::size_t k = coefs_.size();
+	if (k == 0U)
+		return BigInt();
+	if (n_ < k)
+		return (n_ < init_.size()) ? init_[n_] : BigInt(); // missing init is zero
+	// reduce a polynomial of degree < 2k - 1 in place
+	auto reduce = [&](std::vector<BigInt>& poly_) {
+		for (std::size_t i = poly_.size(); i-- > k;)
+		{
+			if (poly_[i].is_zero())
+				continue;
+			for (std::size_t j = 0U; j < k; ++j)
+				poly_[i - 1U - j] += poly_[i] * coefs_[j];
+		}
+		poly_.resize(k);
+	};
+	std::vector<BigInt> poly(k); // x^0
+	poly[0] = BigInt(1);
+	std::size_t pos = 63U;
+	while (((n_ >> pos) & 1U) == 0U)
+		--pos;
+	for (++pos; pos-- != 0U;)
 	{
-		if (is_carry)
+		// square: diagonal once, cross terms doubled
+		std::vector<BigInt> sq(2U * k - 1U);
+		for (std::size_t i = 0U; i < k; ++i)
 		{
-			--l_full_val.b_num_vec[r_i];
-			is_carry = false;
+			if (poly[i].is_zero())
+				continue;
+			sq[2U * i] += square(poly[i]);
+			for (std::size_t j = i + 1U; j < k; ++j)
+				if (!poly[j].is_zero())
+					sq[i + j] += (poly[i] * poly[j]) << 1U;
 		}
-		l_full_val.b_num_vec[r_i] -= r_full_val.b_num_vec[r_i];
-		if (l_full_val.b_num_vec[r_i] < static_cast<std::int8_t>(0))
+		reduce(sq);
+		poly = std::move(sq);
+		if (((n_ >> pos) & 1U) != 0U) // times x
 		{
-			l_full_val.b_num_vec[r_i] += 10;
-			is_carry = true;
+			poly.insert(poly.begin(), BigInt());
+			reduce(poly);
 		}
 	}
-	return l_full_val;
+	BigInt res;
+	for (std::size_t i = 0U; i < k && i < init_.size(); ++i)
+		res += poly[i] * init_[i];
+	return res;
 }
 
 BigInt::~BigInt()
@@ -8,11 +8,26 @@
 
 #include <vector>
 #include <string>
+#include <functional>
+#include <charconv>
+#include <optional>
+#include <memory>
+#include <cstdint>
+
+// std::size_t overloads only where it is a type of its own (32-bit targets, macOS); on LP64 Linux and
+// 64-bit Windows it is std::uint64_t and the std::uint64_t overloads take it; define it for other such targets
+#if !defined(LEZ_SIZE_T_OVERLOADS) && (SIZE_MAX != UINT64_MAX || defined(__APPLE__))
+#define LEZ_SIZE_T_OVERLOADS
+#endif
 
 
 namespace lez
 {
-	// division by zero is zero!
+	// division by zero is zero! / truncates, % takes the sign of the dividend as in C++: -3 % 5 = -3
+	// bitwise operators: two's complement semantics for negatives
+
+	enum class Endian { little, big }; // byte order for BigInt::from_bytes / to_bytes
+	enum class Signedness { as_unsigned, twos_complement }; // as_unsigned: |val|, the sign is dropped
 
 	class BigInt
 	{
@@ -21,24 +36,47 @@ namespace lez
 		BigInt(const BigInt& val_);
 		BigInt(BigInt&& val_);
 		explicit BigInt(std::int32_t val_); // or implicit
+#ifdef LEZ_SIZE_T_OVERLOADS
 		explicit BigInt(std::size_t val_);
+#endif
 		explicit BigInt(std::int64_t val_);
 		explicit BigInt(std::uint64_t val_);
 
 		BigInt& operator=(std::int32_t val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigInt& operator=(std::size_t val_);
+#endif
 		BigInt& operator=(std::int64_t val_);
 		BigInt& operator=(std::uint64_t val_);
 		BigInt& operator=(BigInt val_);
 
+		// saturating; _checked: empty if out of range; _wrapping: low bits of two's complement
 		std::int32_t to_int32() const;
 		std::size_t to_size() const;
 		std::int64_t to_int64() const;
 		std::uint64_t to_uint64() const;
-
-		std::size_t amount_places() const;
+		std::optional<std::int32_t> to_int32_checked() const;
+		std::optional<std::size_t> to_size_checked() const;
+		std::optional<std::int64_t> to_int64_checked() const;
+		std::optional<std::uint64_t> to_uint64_checked() const;
+		std::int32_t to_int32_wrapping() const;
+		std::size_t to_size_wrapping() const;
+		std::int64_t to_int64_wrapping() const;
+		std::uint64_t to_uint64_wrapping() const;
+		bool fits_int32() const;
+		bool fits_size() const;
+		bool fits_int64() const;
+		bool fits_uint64() const;
+
+		std::size_t amount_places() const; // decimal digits
 		bool is_neg() const;
 		bool is_zero() const;
+		bool is_even() const;
+		bool is_odd() const;
+		std::size_t bit_length() const; // |val|, zero = 0
+		std::size_t popcount() const; // |val|
+		std::size_t count_trailing_zeros() const; // zero = 0
+		bool test_bit(std::size_t pos_) const; // two's complement
 		void reverse_neg();
 		void set_neg();
 		void reset_neg();
@@ -46,7 +84,9 @@ namespace lez
 
 		explicit operator bool() const;
 		explicit operator std::int32_t() const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		explicit operator std::size_t() const;
+#endif
 		explicit operator std::int64_t() const;
 		explicit operator std::uint64_t() const;
 
@@ -60,204 +100,451 @@ namespace lez
 		const BigInt operator++(int);
 
 		const BigInt operator+(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		const BigInt operator+(std::size_t r_val_) const;
+#endif
 		const BigInt operator+(std::int64_t r_val_) const;
 		const BigInt operator+(std::uint64_t r_val_) const;
 		const BigInt operator+(const BigInt& r_val_) const;
 
 		const BigInt operator-(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		const BigInt operator-(std::size_t r_val_) const;
+#endif
 		const BigInt operator-(std::int64_t r_val_) const;
 		const BigInt operator-(std::uint64_t r_val_) const;
 		const BigInt operator-(const BigInt& r_val_) const;
 
 		BigInt& operator+=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigInt& operator+=(std::size_t r_val_);
+#endif
 		BigInt& operator+=(std::int64_t r_val_);
 		BigInt& operator+=(std::uint64_t r_val_);
 		BigInt& operator+=(const BigInt& r_val_);
 
 		BigInt& operator-=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigInt& operator-=(std::size_t r_val_);
+#endif
 		BigInt& operator-=(std::int64_t r_val_);
 		BigInt& operator-=(std::uint64_t r_val_);
 		BigInt& operator-=(const BigInt& r_val_);
 
 		friend const BigInt operator+(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend const BigInt operator+(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend const BigInt operator+(std::int64_t l_val_, const BigInt& r_val_);
 		friend const BigInt operator+(std::uint64_t l_val_, const BigInt& r_val_);
 
 		friend const BigInt operator-(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend const BigInt operator-(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend const BigInt operator-(std::int64_t l_val_, const BigInt& r_val_);
 		friend const BigInt operator-(std::uint64_t l_val_, const BigInt& r_val_);
 
 		const BigInt operator*(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		const BigInt operator*(std::size_t r_val_) const;
+#endif
 		const BigInt operator*(std::int64_t r_val_) const;
 		const BigInt operator*(std::uint64_t r_val_) const;
 		const BigInt operator*(const BigInt& r_val_) const;
 
 		const BigInt operator/(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		const BigInt operator/(std::size_t r_val_) const;
+#endif
 		const BigInt operator/(std::int64_t r_val_) const;
 		const BigInt operator/(std::uint64_t r_val_) const;
 		const BigInt operator/(const BigInt& r_val_) const;
 
 		const BigInt operator%(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		const BigInt operator%(std::size_t r_val_) const;
+#endif
 		const BigInt operator%(std::int64_t r_val_) const;
 		const BigInt operator%(std::uint64_t r_val_) const;
 		const BigInt operator%(const BigInt& r_val_) const;
 
 		BigInt& operator*=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigInt& operator*=(std::size_t r_val_);
+#endif
 		BigInt& operator*=(std::int64_t r_val_);
 		BigInt& operator*=(std::uint64_t r_val_);
 		BigInt& operator*=(const BigInt& r_val_);
 
 		BigInt& operator/=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigInt& operator/=(std::size_t r_val_);
+#endif
 		BigInt& operator/=(std::int64_t r_val_);
 		BigInt& operator/=(std::uint64_t r_val_);
 		BigInt& operator/=(const BigInt& r_val_);
 
 		BigInt& operator%=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigInt& operator%=(std::size_t r_val_);
+#endif
 		BigInt& operator%=(std::int64_t r_val_);
 		BigInt& operator%=(std::uint64_t r_val_);
 		BigInt& operator%=(const BigInt& r_val_);
 
 		friend const BigInt operator*(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend const BigInt operator*(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend const BigInt operator*(std::int64_t l_val_, const BigInt& r_val_);
 		friend const BigInt operator*(std::uint64_t l_val_, const BigInt& r_val_);
 
 		friend const BigInt operator/(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend const BigInt operator/(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend const BigInt operator/(std::int64_t l_val_, const BigInt& r_val_);
 		friend const BigInt operator/(std::uint64_t l_val_, const BigInt& r_val_);
 
 		friend const BigInt operator%(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend const BigInt operator%(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend const BigInt operator%(std::int64_t l_val_, const BigInt& r_val_);
 		friend const BigInt operator%(std::uint64_t l_val_, const BigInt& r_val_);
 
 		bool operator>(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator>(std::size_t r_val_) const;
+#endif
 		bool operator>(std::int64_t r_val_) const;
 		bool operator>(std::uint64_t r_val_) const;
 		bool operator>(const BigInt& r_val_) const;
 
 		bool operator<(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator<(std::size_t r_val_) const;
+#endif
 		bool operator<(std::int64_t r_val_) const;
 		bool operator<(std::uint64_t r_val_) const;
 		bool operator<(const BigInt& r_val_) const;
 
 		bool operator>=(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator>=(std::size_t r_val_) const;
+#endif
 		bool operator>=(std::int64_t r_val_) const;
 		bool operator>=(std::uint64_t r_val_) const;
 		bool operator>=(const BigInt& r_val_) const;
 
 		bool operator<=(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator<=(std::size_t r_val_) const;
+#endif
 		bool operator<=(std::int64_t r_val_) const;
 		bool operator<=(std::uint64_t r_val_) const;
 		bool operator<=(const BigInt& r_val_) const;
 
 		bool operator==(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator==(std::size_t r_val_) const;
+#endif
 		bool operator==(std::int64_t r_val_) const;
 		bool operator==(std::uint64_t r_val_) const;
 		bool operator==(const BigInt& r_val_) const;
 
 		bool operator!=(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator!=(std::size_t r_val_) const;
+#endif
 		bool operator!=(std::int64_t r_val_) const;
 		bool operator!=(std::uint64_t r_val_) const;
 		bool operator!=(const BigInt& r_val_) const;
 
 		friend bool operator>(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator>(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend bool operator>(std::int64_t l_val_, const BigInt& r_val_);
 		friend bool operator>(std::uint64_t l_val_, const BigInt& r_val_);
 
 		friend bool operator<(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator<(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend bool operator<(std::int64_t l_val_, const BigInt& r_val_);
 		friend bool operator<(std::uint64_t l_val_, const BigInt& r_val_);
 
 		friend bool operator>=(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator>=(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend bool operator>=(std::int64_t l_val_, const BigInt& r_val_);
 		friend bool operator>=(std::uint64_t l_val_, const BigInt& r_val_);
 
 		friend bool operator<=(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator<=(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend bool operator<=(std::int64_t l_val_, const BigInt& r_val_);
 		friend bool operator<=(std::uint64_t l_val_, const BigInt& r_val_);
 
 		friend bool operator==(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator==(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend bool operator==(std::int64_t l_val_, const BigInt& r_val_);
 		friend bool operator==(std::uint64_t l_val_, const BigInt& r_val_);
 
 		friend bool operator!=(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator!=(std::size_t l_val_, const BigInt& r_val_);
+#endif
 		friend bool operator!=(std::int64_t l_val_, const BigInt& r_val_);
 		friend bool operator!=(std::uint64_t l_val_, const BigInt& r_val_);
 
+		const BigInt operator~() const;
+		const BigInt operator<<(std::size_t shift_) const;
+		const BigInt operator>>(std::size_t shift_) const;
+		BigInt& operator<<=(std::size_t shift_);
+		BigInt& operator>>=(std::size_t shift_);
+
+		const BigInt operator&(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
+		const BigInt operator&(std::size_t r_val_) const;
+#endif
+		const BigInt operator&(std::int64_t r_val_) const;
+		const BigInt operator&(std::uint64_t r_val_) const;
+		const BigInt operator&(const BigInt& r_val_) const;
+
+		const BigInt operator|(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
+		const BigInt operator|(std::size_t r_val_) const;
+#endif
+		const BigInt operator|(std::int64_t r_val_) const;
+		const BigInt operator|(std::uint64_t r_val_) const;
+		const BigInt operator|(const BigInt& r_val_) const;
+
+		const BigInt operator^(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
+		const BigInt operator^(std::size_t r_val_) const;
+#endif
+		const BigInt operator^(std::int64_t r_val_) const;
+		const BigInt operator^(std::uint64_t r_val_) const;
+		const BigInt operator^(const BigInt& r_val_) const;
+
+		BigInt& operator&=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
+		BigInt& operator&=(std::size_t r_val_);
+#endif
+		BigInt& operator&=(std::int64_t r_val_);
+		BigInt& operator&=(std::uint64_t r_val_);
+		BigInt& operator&=(const BigInt& r_val_);
+
+		BigInt& operator|=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
+		BigInt& operator|=(std::size_t r_val_);
+#endif
+		BigInt& operator|=(std::int64_t r_val_);
+		BigInt& operator|=(std::uint64_t r_val_);
+		BigInt& operator|=(const BigInt& r_val_);
+
+		BigInt& operator^=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
+		BigInt& operator^=(std::size_t r_val_);
+#endif
+		BigInt& operator^=(std::int64_t r_val_);
+		BigInt& operator^=(std::uint64_t r_val_);
+		BigInt& operator^=(const BigInt& r_val_);
+
+		friend const BigInt operator&(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
+		friend const BigInt operator&(std::size_t l_val_, const BigInt& r_val_);
+#endif
+		friend const BigInt operator&(std::int64_t l_val_, const BigInt& r_val_);
+		friend const BigInt operator&(std::uint64_t l_val_, const BigInt& r_val_);
+
+		friend const BigInt operator|(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
+		friend const BigInt operator|(std::size_t l_val_, const BigInt& r_val_);
+#endif
+		friend const BigInt operator|(std::int64_t l_val_, const BigInt& r_val_);
+		friend const BigInt operator|(std::uint64_t l_val_, const BigInt& r_val_);
+
+		friend const BigInt operator^(std::int32_t l_val_, const BigInt& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
+		friend const BigInt operator^(std::size_t l_val_, const BigInt& r_val_);
+#endif
+		friend const BigInt operator^(std::int64_t l_val_, const BigInt& r_val_);
+		friend const BigInt operator^(std::uint64_t l_val_, const BigInt& r_val_);
+
 		std::istream& operator>>(std::istream& stream_);
 		std::ostream& operator<<(std::ostream& stream_) const;
 		std::string to_string() const;
 		std::string to_string_unsigned() const;
+		std::string to_string(int base_) const; // 2..62: 0-9a-z up to 36, 0-9A-Za-z above
+
+		// bytes straight from the limbs, no text
+		std::size_t byte_length(Signedness sign_ = Signedness::as_unsigned) const; // minimal, at least 1
+		std::vector<std::uint8_t> to_bytes(Endian endian_ = Endian::big, Signedness sign_ = Signedness::as_unsigned) const;
+		// fills all size_ bytes (zero or sign padded), false and untouched if it does not fit
+		bool export_to(std::uint8_t* data_, std::size_t size_,
+			Endian endian_ = Endian::big, Signedness sign_ = Signedness::as_unsigned) const;
+		// order-preserving key: memcmp order == numeric order, self-delimiting
+		// zero = 0x80; else 0x80 +- length of length, length, magnitude (big-endian, all inverted if negative)
+		std::size_t ordered_key_size() const;
+		std::vector<std::uint8_t> to_ordered_key() const;
+		std::uint8_t* to_ordered_key(std::uint8_t* data_) const; // ordered_key_size() bytes, returns the end
 
 		friend std::istream& operator>>(std::istream& stream_, BigInt& bi_);
 		friend std::ostream& operator<<(std::ostream& stream_, const BigInt& bi_);
+		friend std::to_chars_result to_chars(char* first_, char* last_, const BigInt& val_, int base_);
+		friend std::from_chars_result from_chars(const char* first_, const char* last_, BigInt& val_, int base_);
 
 		static BigInt to_big_int(std::int32_t val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		static BigInt to_big_int(std::size_t val_);
+#endif
 		static BigInt to_big_int(std::int64_t val_);
 		static BigInt to_big_int(std::uint64_t val_);
 		static BigInt to_big_int(const std::string& str_);
 		static void to_big_int(BigInt& bi_, const std::string& str_); // spec
+		static BigInt to_big_int(const std::string& str_, int base_); // 2..62, up to the first non-digit
+		static BigInt from_bytes(const std::uint8_t* data_, std::size_t size_,
+			Endian endian_ = Endian::big, Signedness sign_ = Signedness::as_unsigned);
+		// returns the end of the key, nullptr if malformed
+		static const std::uint8_t* from_ordered_key(const std::uint8_t* first_, const std::uint8_t* last_, BigInt& val_);
 
 		static void swap(BigInt& l_val_, BigInt& r_val_);
 
-		// extra (use in BigReal)
-		static BigInt addition_without_remove_leading_zeros(BigInt l_val_, BigInt r_val_);
-		static BigInt subtraction_without_remove_leading_zeros(BigInt l_val_, BigInt r_val_);
+		// batch: val_ % moduli_[i] for every i (product tree + remainder tree)
+		static std::vector<BigInt> remainders(const BigInt& val_, const std::vector<BigInt>& moduli_);
+		// batch: res[j][i] = vals_[j] % moduli_[i], one product tree for all the values
+		static std::vector<std::vector<BigInt>> remainders(const std::vector<BigInt>& vals_,
+			const std::vector<BigInt>& moduli_);
+		// batch: gcd(moduli_[i], product of all others) for every i, unsigned (the empty product is 1)
+		static std::vector<BigInt> batch_gcd(const std::vector<BigInt>& moduli_);
+		static BigInt gcd(BigInt l_val_, BigInt r_val_); // unsigned
+
+		// lval, 0 = off (default): values of at least this many limbs keep their decimal digits
+		// after the first conversion (to_string, <<, to_chars, StreamWriter, and the BigReal text
+		// through its coefficient) until they change; copies share them, moves and swaps take them along
+		static std::size_t& decimal_cache_limbs();
+		// lval, default = 2^20: the decimal conversions keep 10^(9 * 2^k) and its reciprocal
+		// while the power has at most this many limbs, bigger ones are made on demand and dropped
+		static std::size_t& power_cache_limbs();
+		// drops the kept powers of ten and their reciprocals (safe during conversions)
+		static void clear_caches();
+
+		// sequences (fast doubling, O(log n) squarings)
+		static BigInt fibonacci(std::uint64_t n_);
+		static BigInt lucas(std::uint64_t n_);
+		// a(n) = coefs_[0] * a(n - 1) + ... + coefs_[k - 1] * a(n - k), init_ = a(0) ... a(k - 1)
+		static BigInt linear_recurrence(const std::vector<BigInt>& coefs_, const std::vector<BigInt>& init_,
+			std::uint64_t n_);
 
 		~BigInt();
 
 	private:
-
-		static BigInt append_leading_zeros(BigInt val_, std::size_t size_);
-		static BigInt remove_leading_zeros(BigInt val_);
-
-		static BigInt addition(BigInt l_val_, BigInt r_val_);
-		static BigInt subtraction(BigInt l_val_, BigInt r_val_); // more - less
-
-		static BigInt multiplication(BigInt l_val_, BigInt r_val_); // more * less 
-		static BigInt simple_multiplication(BigInt val_, std::int32_t counter_);
-
-		static BigInt division(BigInt l_val_, BigInt r_val_); // more / less
-		static std::int32_t simple_division(BigInt& val_, const BigInt& subthd_);
-
-		static BigInt modulo_division(BigInt l_val_, BigInt r_val_); // more % less
-
-		// unsigned (can be simplified)
-		static bool logical_more(BigInt l_val_, BigInt r_val_);
-		static bool logical_less(BigInt l_val_, BigInt r_val_);
-		// unsigned, same sizes
-		static bool logical_equal(BigInt l_val_, BigInt r_val_);
-		// from str
+		friend class BigIntParser;
+		friend class StreamWriter;
+		friend class BigReal;
+
+		static BigInt remove_leading_zeros(BigInt val_); // high zero limbs
+		std::uint64_t low_bits() const; // two's complement
+		bool fits_bits(std::size_t digits_, bool is_signed_) const; // digits_ without the sign
+		static BigInt to_big_int_from_magnitude(std::uint64_t mag_, bool is_neg_);
+
+		static BigInt addition(const BigInt& l_val_, const BigInt& r_val_); // unsigned
+		static BigInt subtraction(const BigInt& l_val_, const BigInt& r_val_); // more - less
+
+		static BigInt multiplication(const BigInt& l_val_, const BigInt& r_val_); // unsigned, Karatsuba
+		static BigInt simple_multiplication(const BigInt& l_val_, const BigInt& r_val_); // unsigned, schoolbook
+		static BigInt square(const BigInt& val_); // unsigned, Karatsuba
+		static BigInt simple_square(const BigInt& val_); // unsigned, schoolbook
+		static BigInt ntt_multiplication(const BigInt& l_val_, const BigInt& r_val_); // unsigned, three primes
+		static void ntt(std::vector<std::uint32_t>& vec_, std::uint32_t prime_, bool is_inverse_);
+		static std::uint64_t pow_mod(std::uint64_t base_, std::uint64_t exp_, std::uint32_t mod_);
+		static void split(const BigInt& val_, std::size_t am_limbs_, BigInt& low_, BigInt& high_);
+		static void simple_multiplication(BigInt& val_, std::uint32_t mul_, std::uint32_t add_); // val_ * mul_ + add_
+
+		static BigInt division(const BigInt& l_val_, const BigInt& r_val_); // more / less
+		static BigInt modulo_division(const BigInt& l_val_, const BigInt& r_val_); // more % less
+		static void division_with_remainder(const BigInt& l_val_, const BigInt& r_val_,
+			BigInt& quot_, BigInt& rem_); // unsigned, r_val_ != 0
+		static void long_division(const BigInt& l_val_, const BigInt& r_val_,
+			BigInt& quot_, BigInt& rem_); // Knuth, algorithm D
+		static void newton_division(const BigInt& l_val_, const BigInt& r_val_, const BigInt& inv_,
+			BigInt& quot_, BigInt& rem_); // inv_ = reciprocal of r_val_ normalized
+		static BigInt reciprocal(const BigInt& val_); // about B^2n / val_, n limbs, top bit set
+		static std::uint32_t simple_division(BigInt& val_, std::uint32_t div_); // ret remainder
+
+		// unsigned
+		static bool logical_more(const BigInt& l_val_, const BigInt& r_val_);
+		static bool logical_less(const BigInt& l_val_, const BigInt& r_val_);
+		static bool logical_equal(const BigInt& l_val_, const BigInt& r_val_);
+		// bits
+		static std::size_t limb_bit_length(std::uint32_t limb_);
+		static std::vector<std::uint32_t> to_twos_complement(const BigInt& val_, std::size_t size_);
+		static BigInt from_twos_complement(std::vector<std::uint32_t> vec_); // sign from the top bit
+		static BigInt bitwise_operation(const BigInt& l_val_, const BigInt& r_val_,
+			std::uint32_t (*op_)(std::uint32_t, std::uint32_t));
+		// from str / to str, divide and conquer on big values
 		static BigInt read_big_int(const std::string& str_, std::size_t st_p_);
-
-		std::vector<std::int8_t> b_num_vec;
+		static void read_digits(const char* first_, const char* last_, BigInt& val_); // digits only
+		static void simple_read_digits(const char* first_, const char* last_, BigInt& val_);
+		// |val_| in pieces, leading digits first; false as soon as out_ returns false
+		static bool write_decimal(const BigInt& val_, const std::function<bool(const char*, std::size_t)>& out_);
+		static std::size_t decimal_level(const BigInt& val_); // val_ < 10^(9 * 2^level)
+		static bool is_decimal_cacheable(const BigInt& val_); // big enough for decimal_cache_limbs()
+		static bool write_digits(const BigInt& val_, std::size_t level_, bool is_padded_,
+			const std::function<bool(const char*, std::size_t)>& out_); // val_ < 10^(9 * 2^level_)
+		static std::string simple_write_digits(const BigInt& val_, int base_);
+		struct DecimalCache;
+		static DecimalCache& decimal_cache();
+		// 10^(9 * 2^level_), cached up to power_cache_limbs()
+		static std::shared_ptr<const BigInt> power_of_ten(std::size_t level_);
+		static void division_by_power_of_ten(const BigInt& val_, std::size_t level_,
+			BigInt& quot_, BigInt& rem_); // unsigned, reciprocal cached with the power
+		// any base, powers_[level] = chunk_base^(2^level)
+		static void write_digits(const BigInt& val_, int base_, const std::vector<BigInt>& powers_,
+			std::size_t level_, bool is_padded_, std::string& str_);
+		static void write_power_of_two_digits(const BigInt& val_, int base_, char* first_, char* last_);
+		static void read_digits(const char* first_, const char* last_, int base_, BigInt& val_);
+		static void read_digits(const char* first_, const char* last_, int base_,
+			const std::vector<BigInt>& powers_, BigInt& val_);
+		static void simple_read_digits(const char* first_, const char* last_, int base_, BigInt& val_);
+		static void read_power_of_two_digits(const char* first_, const char* last_, int base_, BigInt& val_);
+		static std::size_t power_of_two_bits(int base_); // 0 if base_ is not a power of two
+		static std::size_t chunk_length(int base_, std::uint32_t& chunk_base_); // digits in a limb
+		static std::uint32_t digit_value(char ch_, int base_); // >= base_ if not a digit
+		static char digit_char(std::uint32_t dig_, int base_);
+		// levels from leaves (front) to root (back), unsigned
+		static std::vector<std::vector<BigInt>> product_tree(const std::vector<BigInt>& leaves_);
+		static std::vector<BigInt> remainder_leaves(const std::vector<BigInt>& moduli_); // |m|, zero as one
+		// val_ % leaf for every leaf of tree_, down the remainder tree; signed as in operator%
+		static std::vector<BigInt> remainder_tree(const BigInt& val_, const std::vector<std::vector<BigInt>>& tree_);
+		// fn_(0) ... fn_(am_ - 1) on all hardware threads (nodes of one tree level), the caller takes a share;
+		// serially if am_limbs_ (operands of all the calls) < parallel_limbs or inside a worker (no nesting);
+		// the first exception of a call is rethrown after all the threads have joined
+		static void parallel_for(std::size_t am_, std::size_t am_limbs_, const std::function<void(std::size_t)>& fn_);
+		static std::size_t amount_limbs(const std::vector<BigInt>& vals_);
+		// F(n_) and F(n_ - 1)
+		static void fibonacci_pair(std::uint64_t n_, BigInt& fn_, BigInt& fn_1_);
+
+		static const std::size_t newton_threshold = 384U; // divisor limbs
+		static const std::size_t parallel_limbs = 4096U; // less work than a few thread starts below it
+
+		std::vector<std::uint32_t> b_num_vec; // binary limbs, little-endian, base 2^32, zero is empty
 		bool b_is_neg;
+		mutable std::shared_ptr<const std::string> b_dec_cache; // digits of |val|, see decimal_cache_limbs()
 	};
+
+	// std::to_chars / std::from_chars conventions, base_ 2..62 as in to_string(base_)
+	// no allocations for powers of two and for base 10 below 64 limbs
+	// [-]digits; short buffer: ret { last_, std::errc::value_too_large }
+	std::to_chars_result to_chars(char* first_, char* last_, const BigInt& val_, int base_ = 10);
+	// [-]digits; no digits: ret { first_, std::errc::invalid_argument }, val_ is not changed
+	std::from_chars_result from_chars(const char* first_, const char* last_, BigInt& val_, int base_ = 10);
 }
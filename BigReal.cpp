@@ -7,37 +7,39 @@
 
 #include <utility>
 #include <cmath>
-#include <sstream>
+#include <istream>
+#include <ostream>
 #include <algorithm>
+#include <limits>
 
 #include "BigReal.h"
 #include "BigInt.h"
+#include "Digits.h"
+#include "Parser.h"
+#include "Writer.h"
 
 
 namespace lez
 {
 
 BigReal::BigReal() :
-	b_whole_part(1U, static_cast<std::int8_t>(0)), // zero
-	b_fractional_part(1U, static_cast<std::int8_t>(0)),
-	b_am_dig_after_com(start_amount_digits_after_comma()),
-	b_is_neg(false)
+	b_coef(), // zero
+	b_exp(0),
+	b_am_dig_after_com(start_amount_digits_after_comma())
 {
 }
 
 BigReal::BigReal(const BigReal& val_) :
-	b_whole_part(val_.b_whole_part),
-	b_fractional_part(val_.b_fractional_part),
-	b_am_dig_after_com(val_.b_am_dig_after_com),
-	b_is_neg(val_.b_is_neg)
+	b_coef(val_.b_coef),
+	b_exp(val_.b_exp),
+	b_am_dig_after_com(val_.b_am_dig_after_com)
 {
 }
 
 BigReal::BigReal(BigReal&& val_) :
-	b_whole_part(std::move(val_.b_whole_part)),
-	b_fractional_part(std::move(val_.b_fractional_part)),
-	b_am_dig_after_com(val_.b_am_dig_after_com),
-	b_is_neg(val_.b_is_neg)
+	b_coef(std::move(val_.b_coef)),
+	b_exp(val_.b_exp),
+	b_am_dig_after_com(val_.b_am_dig_after_com)
 {
 }
 
@@ -47,11 +49,13 @@ BigReal::BigReal(std::int32_t val_) :
 	*this = to_big_real(val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigReal::BigReal(std::size_t val_) :
 	BigReal()
 {
 	*this = to_big_real(val_);
 }
+#endif
 
 BigReal::BigReal(std::int64_t val_) :
 	BigReal()
@@ -92,11 +96,13 @@ BigReal& BigReal::operator=(std::int32_t val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigReal& BigReal::operator=(std::size_t val_)
 {
 	*this = to_big_real(val_);
 	return *this;
 }
+#endif
 
 BigReal& BigReal::operator=(std::int64_t val_)
 {
@@ -138,54 +144,197 @@ BigReal& BigReal::operator=(BigReal val_)
 // ----------------------------------------------------------------------------
 // to type
 std::int32_t BigReal::to_int32() const
-{	
-	BigInt bi;
-	BigInt::to_big_int(bi, to_string_whole_part());
-	return bi.to_int32();
+{
+	return clamped_big_int().to_int32();
 }
 
 std::size_t BigReal::to_size() const
 {
-	BigInt bi;
-	BigInt::to_big_int(bi, to_string_whole_part());
-	return bi.to_size();
+	return clamped_big_int().to_size();
 }
 
 std::int64_t BigReal::to_int64() const
 {
-	BigInt bi;
-	BigInt::to_big_int(bi, to_string_whole_part());
-	return bi.to_int64();
+	return clamped_big_int().to_int64();
 }
 
 std::uint64_t BigReal::to_uint64() const
 {
-	BigInt bi;
-	BigInt::to_big_int(bi, to_string_whole_part());
-	return bi.to_uint64();
+	return clamped_big_int().to_uint64();
+}
+
+std::optional<std::int32_t> BigReal::to_int32_checked() const
+{
+	return clamped_big_int().to_int32_checked();
+}
+
+std::optional<std::size_t> BigReal::to_size_checked() const
+{
+	return clamped_big_int().to_size_checked();
+}
+
+std::optional<std::int64_t> BigReal::to_int64_checked() const
+{
+	return clamped_big_int().to_int64_checked();
+}
+
+std::optional<std::uint64_t> BigReal::to_uint64_checked() const
+{
+	return clamped_big_int().to_uint64_checked();
+}
+
+std::int32_t BigReal::to_int32_wrapping() const
+{
+	return static_cast<std::int32_t>(to_uint64_wrapping());
+}
+
+std::size_t BigReal::to_size_wrapping() const
+{
+	return static_cast<std::size_t>(to_uint64_wrapping());
+}
+
+std::int64_t BigReal::to_int64_wrapping() const
+{
+	return static_cast<std::int64_t>(to_uint64_wrapping());
+}
+
+std::uint64_t BigReal::to_uint64_wrapping() const
+{
+	// coef * 10^exp modulo 2^64, 2^64 divides 10^64
+	if (b_exp < 20)
+		return to_big_int().to_uint64_wrapping();
+	if (b_exp >= 64)
+		return 0U;
+	std::uint64_t mul = 1U;
+	for (std::int64_t i = 0; i != b_exp; ++i)
+		mul *= 10U;
+	return b_coef.to_uint64_wrapping() * mul;
+}
+
+bool BigReal::fits_int32() const
+{
+	return clamped_big_int().fits_int32();
+}
+
+bool BigReal::fits_size() const
+{
+	return clamped_big_int().fits_size();
+}
+
+bool BigReal::fits_int64() const
+{
+	return clamped_big_int().fits_int64();
+}
+
+bool BigReal::fits_uint64() const
+{
+	return clamped_big_int().fits_uint64();
 }
 
 BigInt BigReal::to_big_int() const
 {
-	BigInt bi;
-	BigInt::to_big_int(bi, to_string_whole_part());
-	return bi;
+	// toward zero
+	if (b_exp >= 0)
+		return scaled(b_coef, static_cast<std::size_t>(b_exp));
+	std::size_t am_frac = static_cast<std::size_t>(-(b_exp + 1)) + 1U;
+	if (am_frac >= b_coef.bit_length())
+		return BigInt(); // 10^am_frac > 2^am_frac > |coef|
+	BigInt mag = b_coef;
+	mag.reset_neg();
+	BigInt res = mag / power(10U, am_frac);
+	if (b_coef.is_neg())
+		res.set_neg();
+	return res;
+}
+
+BigInt BigReal::clamped_big_int() const
+{
+	// 10^20 > 2^64: out of every range of the extractors with its sign, so not expanded
+	if (b_exp < 20)
+		return to_big_int();
+	BigInt res = BigInt(1) << 64U;
+	if (is_neg())
+		res.set_neg();
+	return res;
 }
 
 float BigReal::to_float() const
 {
-	std::stringstream ss(to_string());
-	float val = 0.0;
-	ss >> val;
-	return val;
+	// exact in double, rounded once
+	return static_cast<float>(to_binary(std::numeric_limits<float>::digits,
+		std::numeric_limits<float>::min_exponent, std::numeric_limits<float>::max_exponent));
 }
 
 double BigReal::to_double() const
 {
-	std::stringstream ss(to_string());
-	double val = 0.0;
-	ss >> val;
-	return val;
+	return to_binary(std::numeric_limits<double>::digits,
+		std::numeric_limits<double>::min_exponent, std::numeric_limits<double>::max_exponent);
+}
+
+double BigReal::to_binary(int digits_, int min_exp_, int max_exp_) const
+{
+	if (is_zero())
+		return 0.0;
+	double sign = b_coef.is_neg() ? -1.0 : 1.0;
+	// 10^digits_low <= |coef| < 10^digits_high
+	if (exponent_gap(b_exp, max_exp_ * 3 / 10 + 1) > -digits_low(b_coef))
+		return sign * std::numeric_limits<double>::infinity();
+	if (exponent_gap(b_exp, -((digits_ - min_exp_ + 1) * 3 / 10 + 4)) < -digits_high(b_coef))
+		return sign * 0.0; // below half of the least subnormal
+
+	// integer with 64 bits at least: val = (bits + sticky) * 2^exp2
+	BigInt bits = b_coef;
+	bits.reset_neg();
+	bool is_sticky = false;
+	std::int64_t exp2 = 0;
+	if (b_exp >= 0)
+		bits *= power(10U, static_cast<std::size_t>(b_exp));
+	else
+	{
+		std::size_t am_dig = static_cast<std::size_t>(-(b_exp + 1)) + 1U;
+		BigInt den = power(10U, am_dig);
+		std::size_t len_den = den.bit_length();
+		if (bits.bit_length() > len_den + 130U) // the low bits only count as sticky
+		{
+			std::size_t drop = bits.bit_length() - len_den - 130U;
+			is_sticky = bits.count_trailing_zeros() < drop;
+			bits >>= drop;
+			exp2 = static_cast<std::int64_t>(drop);
+		}
+		std::size_t shift = len_den + 66U > bits.bit_length() ? len_den + 66U - bits.bit_length() : 0U;
+		BigInt num = bits << shift;
+		bits = num / den;
+		is_sticky = is_sticky || !(num - bits * den).is_zero();
+		exp2 -= static_cast<std::int64_t>(shift);
+	}
+	std::size_t len = bits.bit_length();
+	std::uint64_t top = 0U; // most significant bit is set
+	if (len <= 64U)
+		top = bits.to_uint64_wrapping() << (64U - len);
+	else
+	{
+		top = (bits >> (len - 64U)).to_uint64_wrapping();
+		is_sticky = is_sticky || bits.count_trailing_zeros() < len - 64U;
+	}
+	exp2 += static_cast<std::int64_t>(len) - 64;
+
+	// round half to even at digits_ bits, fewer below the normal range
+	std::int64_t lead_exp = exp2 + 63; // 2^lead_exp <= val < 2^(lead_exp + 1)
+	if (lead_exp >= max_exp_)
+		return sign * std::numeric_limits<double>::infinity();
+	std::int64_t am_keep = digits_;
+	if (lead_exp < min_exp_ - 1)
+		am_keep -= min_exp_ - 1 - lead_exp;
+	if (am_keep < 0)
+		return sign * 0.0;
+	int shift = 64 - static_cast<int>(am_keep); // 64 - digits_ .. 64
+	std::uint64_t kept = shift == 64 ? 0U : top >> shift;
+	std::uint64_t half = static_cast<std::uint64_t>(1U) << (shift - 1);
+	if ((top & half) != 0U && ((top & (half - 1U)) != 0U || is_sticky || (kept & 1U) != 0U))
+		++kept;
+	if (am_keep == digits_ && (kept >> am_keep) != 0U && lead_exp + 1 >= max_exp_)
+		return sign * std::numeric_limits<double>::infinity(); // carried out of the range
+	return sign * std::ldexp(static_cast<double>(kept), static_cast<int>(exp2 + shift));
 }
 
 
@@ -193,51 +342,60 @@ double BigReal::to_double() const
 // extra
 std::size_t BigReal::amount_places() const
 {
-	return b_whole_part.size() + b_fractional_part.size();
+	return amount_places_whole_part() + amount_places_fractional_part();
 }
 
 std::size_t BigReal::amount_places_whole_part() const
 {
-	return b_whole_part.size();
+	if (b_exp > 0 && !is_zero())
+		return b_coef.to_string_unsigned().length() + static_cast<std::size_t>(b_exp);
+	std::string whole, frac;
+	split_digits(whole, frac, 0U);
+	return whole.length();
 }
 
 std::size_t BigReal::amount_places_fractional_part() const
 {
-	return b_fractional_part.size();
+	if (b_exp >= 0)
+		return 1U; // "0"
+	std::string whole, frac;
+	split_digits(whole, frac, std::numeric_limits<std::size_t>::max());
+	return frac.length();
+}
+
+const BigInt& BigReal::coefficient() const
+{
+	return b_coef;
+}
+
+std::int64_t BigReal::exponent() const
+{
+	return b_exp;
 }
 
 bool BigReal::is_neg() const
 {
-	return b_is_neg;
+	return b_coef.is_neg();
 }
 
 bool BigReal::is_zero() const
 {
-	for (const auto& val : b_whole_part)
-		if (val != static_cast<std::int8_t>(0))
-			return false;
-	for (const auto& val : b_fractional_part)
-		if (val != static_cast<std::int8_t>(0))
-			return false;
-	return true;
+	return b_coef.is_zero();
 }
 
 void BigReal::reverse_neg()
 {
-	if (b_is_neg)
-		reset_neg();
-	else
-		set_neg();
+	b_coef.reverse_neg();
 }
 
 void BigReal::set_neg()
 {
-	b_is_neg = !is_zero();
+	b_coef.set_neg();
 }
 
 void BigReal::reset_neg()
 {
-	b_is_neg = false;
+	b_coef.reset_neg();
 }
 
 void BigReal::reset()
@@ -258,10 +416,12 @@ BigReal::operator std::int32_t() const
 	return to_int32();
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigReal::operator std::size_t() const
 {
 	return to_size();
 }
+#endif
 
 BigReal::operator std::int64_t() const
 {
@@ -294,7 +454,7 @@ BigReal::operator double() const
 const BigReal BigReal::operator-() const
 {
 	BigReal br(*this);
-	br.b_is_neg = (br.b_is_neg) ? false : !br.is_zero();
+	br.b_coef.reverse_neg();
 	return br;
 }
 
@@ -336,11 +496,13 @@ const BigReal BigReal::operator+(std::int32_t r_val_) const
 	return operator+(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigReal BigReal::operator+(std::size_t r_val_) const
 {
 	BigReal r_val = to_big_real(r_val_);
 	return operator+(r_val);
 }
+#endif
 
 const BigReal BigReal::operator+(std::int64_t r_val_) const
 {
@@ -374,135 +536,58 @@ const BigReal BigReal::operator+(double r_val_) const
 
 const BigReal BigReal::operator+(const BigReal& r_val_) const
 {
-	BigReal res;
+	// coefficients at the smaller scale, unless one summand lies wholly below am_prec digits of the other:
+	// then it is a sticky digit under the fractional digits and 64 more (the same for every rounding above it)
+	// instead of a huge shift; am_prec: the digits of both and exponent_zeros_limit() or the fractional digits
 	std::size_t max_am_dig_after_com = std::max(b_am_dig_after_com, r_val_.b_am_dig_after_com);
-	if (is_neg() == r_val_.is_neg()) // only pos or neg
-	{
-		res = addition_positive_or_negative_numbers(*this, r_val_); // without check
-		res.set_amount_digits_after_comma(max_am_dig_after_com);
-		return res;
-	}
-	if (!is_neg() && r_val_.is_neg())
-	{
-		res = subtraction(*this, r_val_); // pos + neg
-		res.set_amount_digits_after_comma(max_am_dig_after_com);
-		return res;
-	}
-	res = subtraction(r_val_, *this); // neg + pos
-	res.set_amount_digits_after_comma(max_am_dig_after_com);
-	return res;
-}
-
-BigReal BigReal::addition_positive_or_negative_numbers(const BigReal& l_val_, const BigReal& r_val_)
-{
 	BigReal res;
-	BigInt l_val_fp, r_val_fp, res_fp;
-	BigInt l_val_wp, r_val_wp, res_wp;
-	// numbers as strings
-	std::string l_val_fp_str = l_val_.to_string_fractional_part();
-	std::string r_val_fp_str = r_val_.to_string_fractional_part();
-	append_end_zeros_by_general_size(l_val_fp_str, r_val_fp_str);
-
-	BigInt::to_big_int(l_val_fp, l_val_fp_str);
-	BigInt::to_big_int(r_val_fp, r_val_fp_str);
-	BigInt::to_big_int(l_val_wp, l_val_.to_string_unsigned_whole_part());
-	BigInt::to_big_int(r_val_wp, r_val_.to_string_unsigned_whole_part());
-
-	res_fp = l_val_fp + r_val_fp;
-	res_wp = l_val_wp + r_val_wp;
-	if (is_carry_after_addition_fractional_part(l_val_fp, r_val_fp, res_fp))
+	if (r_val_.is_zero() || is_zero())
+		res = is_zero() ? r_val_ : *this;
+	else if (b_exp == r_val_.b_exp)
 	{
-		++res_wp;
-		res_fp = remove_first_number_from_big_int(res_fp);
+		res.b_coef = b_coef + r_val_.b_coef;
+		res.b_exp = b_exp;
 	}
-
-	res = to_big_real_from_big_int(res_wp, res_fp);
-	if (l_val_.is_neg() && r_val_.is_neg()) // should be equal
-	{
-		res.set_neg();
-	}
-	return res;
-}
-
-BigReal BigReal::subtraction(const BigReal& l_val_, const BigReal& r_val_)
-{
-	BigReal res;
-	bool is_l_val_more = logical_more(l_val_ , r_val_);
-	if (is_l_val_more)
-	{
-		res = subtraction_in_order(l_val_, r_val_);
-		return res;
-	}
-	res = subtraction_in_order(r_val_, l_val_);
-	res.set_neg();
-	return res;
-}
-
-BigReal BigReal::subtraction_in_order(const BigReal& l_val_, const BigReal& r_val_)
-{
-	BigReal res;
-	BigInt l_val_fp, r_val_fp, res_fp;
-	BigInt l_val_wp, r_val_wp, res_wp;
-	// numbers as strings
-	std::string l_val_fp_str = l_val_.to_string_fractional_part();
-	std::string r_val_fp_str = r_val_.to_string_fractional_part();
-	append_end_zeros_by_general_size(l_val_fp_str, r_val_fp_str);
-
-	BigInt::to_big_int(l_val_fp, l_val_fp_str);
-	BigInt::to_big_int(r_val_fp, r_val_fp_str);
-	BigInt::to_big_int(l_val_wp, l_val_.to_string_unsigned_whole_part());
-	BigInt::to_big_int(r_val_wp, r_val_.to_string_unsigned_whole_part());
-
-	bool is_carry = false;
-
-	if (r_val_fp > l_val_fp)
+	else
 	{
-		l_val_fp_str.insert(0U, 1U, '1');
-		BigInt::to_big_int(l_val_fp, l_val_fp_str);
-		is_carry = true;
-		--l_val_wp;
+		std::int64_t gap = exponent_gap(b_exp, r_val_.b_exp);
+		bool is_l_big = gap > digits_high(r_val_.b_coef) - digits_high(b_coef);
+		const BigReal& big = is_l_big ? *this : r_val_;
+		const BigReal& small = is_l_big ? r_val_ : *this;
+		std::int64_t dig_big = digits_high(big.b_coef);
+		std::int64_t dig_small = digits_high(small.b_coef);
+		std::int64_t am_frac = static_cast<std::int64_t>(std::min<std::size_t>(max_am_dig_after_com, std::size_t(1) << 40U));
+		std::int64_t am_prec = dig_big + dig_small + std::max(am_frac,
+			static_cast<std::int64_t>(std::min<std::size_t>(exponent_zeros_limit(), std::size_t(1) << 40U)));
+		if ((is_l_big ? gap : -gap) > am_prec - dig_big + dig_small)
+		{
+			// |small| < 10^(big.b_exp - am_prec + dig_big - 1), 10^(big.b_exp - am_shift) instead
+			std::size_t am_shift = static_cast<std::size_t>(std::min(am_prec - dig_big, am_frac + 64)) + 1U;
+			res.b_coef = scaled(big.b_coef, am_shift);
+			if (small.is_neg())
+				res.b_coef -= 1;
+			else
+				res.b_coef += 1;
+			res.b_exp = big.b_exp - static_cast<std::int64_t>(am_shift);
+		}
+		else if (b_exp < r_val_.b_exp)
+		{
+			res.b_coef = b_coef + scaled(r_val_.b_coef, static_cast<std::size_t>(r_val_.b_exp - b_exp));
+			res.b_exp = b_exp;
+		}
+		else
+		{
+			res.b_coef = scaled(b_coef, static_cast<std::size_t>(b_exp - r_val_.b_exp)) + r_val_.b_coef;
+			res.b_exp = r_val_.b_exp;
+		}
 	}
-	res_fp = BigInt::subtraction_without_remove_leading_zeros(l_val_fp, r_val_fp); // save leading zeros
-	if (is_carry)
-		res_fp = remove_first_number_from_big_int(res_fp);
-	res_wp = l_val_wp - r_val_wp;
-	res = to_big_real_from_big_int(res_wp, res_fp);
+	if (res.b_coef.is_zero())
+		res.b_exp = 0;
+	res.set_amount_digits_after_comma(max_am_dig_after_com);
+	res.bound();
 	return res;
 }
 
-bool BigReal::is_carry_after_addition_fractional_part(const BigInt& l_val_,
-	const BigInt& r_val_,
-	const BigInt& res_)
-{
-	std::size_t max_ap = std::max(l_val_.amount_places(), r_val_.amount_places());
-	if (res_.amount_places() > max_ap)
-		return true;
-	return false;
-}
-
-BigInt BigReal::remove_first_number_from_big_int(const BigInt& val_)
-{
-	std::string val = val_.to_string();
-	std::size_t pos_for_remove = 0U;
-	if (val.front() == '-')
-		++pos_for_remove;
-	val.erase(pos_for_remove, 1U);
-	return BigInt::to_big_int(val);
-}
-
-BigReal BigReal::to_big_real_from_big_int(const BigInt& wp_val_, const BigInt& fp_val_)
-{
-	std::string str_wp = wp_val_.to_string();
-	remove_leading_zeros(str_wp);
-	std::string str_fp = fp_val_.to_string_unsigned(); // only positive
-	remove_end_zeros(str_fp);
-	std::string str_res;
-	str_res += str_wp;
-	str_res += '.';
-	str_res += str_fp;
-	return BigReal::to_big_real(str_res);
-}
-
 
 // ----------------------------------------------------------------------------
 // arithmetic -
@@ -512,11 +597,13 @@ const BigReal BigReal::operator-(std::int32_t r_val_) const
 	return operator-(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigReal BigReal::operator-(std::size_t r_val_) const
 {
 	BigReal r_val = to_big_real(r_val_);
 	return operator-(r_val);
 }
+#endif
 
 const BigReal BigReal::operator-(std::int64_t r_val_) const
 {
@@ -550,24 +637,7 @@ const BigReal BigReal::operator-(double r_val_) const
 
 const BigReal BigReal::operator-(const BigReal& r_val_) const
 {
-	BigReal cp_r_val = r_val_;
-	if (!is_neg() && !cp_r_val.is_neg())
-	{
-		cp_r_val.b_is_neg = true;
-		return operator+(cp_r_val);
-	}
-	if (is_neg() && cp_r_val.is_neg())
-	{
-		cp_r_val.b_is_neg = false;
-		return operator+(cp_r_val);
-	}
-	if (!is_neg() && cp_r_val.is_neg())
-	{
-		cp_r_val.b_is_neg = false;
-		return operator+(cp_r_val);
-	}
-	cp_r_val.b_is_neg = true;
-	return operator+(cp_r_val);
+	return operator+(-r_val_);
 }
 
 
@@ -579,11 +649,13 @@ BigReal& BigReal::operator+=(std::int32_t r_val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigReal& BigReal::operator+=(std::size_t r_val_)
 {
 	*this = this->operator+(r_val_);
 	return *this;
 }
+#endif
 
 BigReal& BigReal::operator+=(std::int64_t r_val_)
 {
@@ -627,11 +699,13 @@ BigReal& BigReal::operator-=(std::int32_t r_val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigReal& BigReal::operator-=(std::size_t r_val_)
 {
 	*this = this->operator-(r_val_);
 	return *this;
 }
+#endif
 
 BigReal& BigReal::operator-=(std::int64_t r_val_)
 {
@@ -677,10 +751,12 @@ const BigReal operator+(std::int32_t l_val_, const BigReal& r_val_)
 	return r_val_.operator+(l_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigReal operator+(std::size_t l_val_, const BigReal& r_val_)
 {
 	return r_val_.operator+(l_val_);
 }
+#endif
 
 const BigReal operator+(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -713,11 +789,13 @@ const BigReal operator-(std::int32_t l_val_, const BigReal& r_val_)
 	return l_val.operator-(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigReal operator-(std::size_t l_val_, const BigReal& r_val_)
 {
 	BigReal l_val = BigReal::to_big_real(l_val_);
 	return l_val.operator-(r_val_);
 }
+#endif
 
 const BigReal operator-(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -758,11 +836,13 @@ const BigReal BigReal::operator*(std::int32_t r_val_) const
 	return operator*(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigReal BigReal::operator*(std::size_t r_val_) const
 {
 	BigReal r_val = BigReal::to_big_real(r_val_);
 	return operator*(r_val);
 }
+#endif
 
 const BigReal BigReal::operator*(std::int64_t r_val_) const
 {
@@ -796,34 +876,72 @@ const BigReal BigReal::operator*(double r_val_) const
 
 const BigReal BigReal::operator*(const BigReal& r_val_) const
 {
-	std::string l_val_str = to_string_whole_part() + to_string_fractional_part();
-	std::string r_val_str = r_val_.to_string_whole_part() + r_val_.to_string_fractional_part();
-	BigInt l_val = BigInt::to_big_int(l_val_str);
-	BigInt r_val = BigInt::to_big_int(r_val_str);
-	l_val *= r_val;
-	std::string res_str = l_val.to_string();
-	std::size_t offset = b_fractional_part.size() + r_val_.b_fractional_part.size();
-	set_comma_in_result_string_after_multiplication(res_str, offset);
-	std::size_t max_am_dig_after_com = std::max(b_am_dig_after_com, r_val_.b_am_dig_after_com);
-	BigReal res = BigReal::to_big_real(res_str);
-	res.set_amount_digits_after_comma(max_am_dig_after_com);
+	// the scales add up; a bounded result (guard_digits()) needs only the high part of the product
+	BigReal res;
+	res.set_amount_digits_after_comma(std::max(b_am_dig_after_com, r_val_.b_am_dig_after_com));
+	std::int64_t exp = 0;
+	bool is_exp = add_exponents(b_exp, r_val_.b_exp, exp); // false: beyond int64
+	if (is_zero() || r_val_.is_zero() || (!is_exp && b_exp > 0))
+		return res; // zero, as is a product too large for the exponent
+	if (guard_digits() != std::string::npos)
+	{
+		std::int64_t exp_to = -static_cast<std::int64_t>(std::min<std::size_t>(res.bounded_digits(),
+			static_cast<std::size_t>(std::numeric_limits<std::int64_t>::max())));
+		std::int64_t am_drop = is_exp ? exponent_gap(exp_to, exp) : std::numeric_limits<std::int64_t>::max();
+		bool is_neg = this->is_neg() != r_val_.is_neg();
+		if (am_drop > digits_high(b_coef) + digits_high(r_val_.b_coef))
+		{
+			// |product| < 10^(exp_to - 1): less than half a unit
+			round_quotient(res.b_coef, -1, true, is_neg, start_rounding());
+			if (is_neg)
+				res.b_coef.set_neg();
+			res.b_exp = res.b_coef.is_zero() ? 0 : exp_to;
+			return res;
+		}
+		if (am_drop > 0 && short_product(b_coef, r_val_.b_coef, static_cast<std::size_t>(am_drop), is_neg,
+			start_rounding(), res.b_coef))
+		{
+			res.b_exp = res.b_coef.is_zero() ? 0 : exp_to;
+			return res;
+		}
+	}
+	if (!is_exp)
+		return res; // zero, the exact product is below the exponent
+	res.b_coef = b_coef * r_val_.b_coef;
+	res.b_exp = exp;
+	res.bound();
 	return res;
 }
 
-void BigReal::set_comma_in_result_string_after_multiplication(std::string& res_str_, std::size_t offset_from_end_for_com_)
+bool BigReal::short_product(const BigInt& l_coef_, const BigInt& r_coef_, std::size_t am_drop_, bool is_neg_,
+	DecimalRounding mode_, BigInt& res_)
 {
-	if (res_str_ == "0") // private case
-	{
-		res_str_.insert(1U, ".0");
-		return;
-	}
-	if (res_str_.length() <= offset_from_end_for_com_)
-	{
-		res_str_.insert(0U, offset_from_end_for_com_ - res_str_.length(), '0');
-		res_str_.insert(0U, "0.");
-		return;
-	}
-	res_str_.insert(res_str_.length() - offset_from_end_for_com_, 1U, '.'); // it works?
+	// neither the exact product nor 10^am_drop_: each operand loses low bits worth less than 2^(am_bits - 8)
+	// of the product, 2^am_bits <= 10^am_drop_ (log2(10) > 3.321), and 10^am_drop_ = 5^am_drop_ * 2^am_drop_
+	// comes from the high bits of the power; the quotient is then known in 2^-16 steps within a small interval
+	std::size_t am_bits = am_drop_ * 3321U / 1000U;
+	std::size_t len_l = l_coef_.bit_length();
+	std::size_t len_r = r_coef_.bit_length();
+	std::size_t shift_l = (am_bits > len_r + 8U) ? am_bits - len_r - 8U : 0U;
+	std::size_t shift_r = (am_bits > len_l + 8U) ? am_bits - len_l - 8U : 0U;
+	if (shift_l == 0U && shift_r == 0U)
+		return false; // nothing to save
+	BigInt l_mag = l_coef_;
+	BigInt r_mag = r_coef_;
+	l_mag.reset_neg();
+	r_mag.reset_neg();
+	BigInt prod = (l_mag >> shift_l) * (r_mag >> shift_r);
+
+	// |l * r| / 10^am_drop_ < 2^am_quot_bits, the power is precise enough for 2^-20 of it
+	std::int64_t am_quot_bits = static_cast<std::int64_t>(len_l + len_r) - static_cast<std::int64_t>(am_bits);
+	std::int64_t pow_exp = 0;
+	BigInt pow = power_high(BigInt::to_big_int(static_cast<std::uint64_t>(5U)), am_drop_, static_cast<std::size_t>(std::max<std::int64_t>(am_quot_bits, 0)) + 40U, pow_exp);
+	std::int64_t shift = static_cast<std::int64_t>(shift_l + shift_r) - static_cast<std::int64_t>(am_drop_) - pow_exp + 16;
+	BigInt est = (shift >= 0) ? (prod << static_cast<std::size_t>(shift)) / pow : prod / (pow << static_cast<std::size_t>(-shift));
+
+	// |l * r| / 10^am_drop_ * 2^16 lies in (est - 1, est + 513): the power gives less than 1 too much,
+	// the lost bits less than 2^16 / 128 too little; the product is not zero
+	return round_bounds(est.is_zero() ? est : est - 1, est + 513, is_neg_, mode_, res_);
 }
 
 
@@ -835,11 +953,13 @@ const BigReal BigReal::operator/(std::int32_t r_val_) const
 	return operator/(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigReal BigReal::operator/(std::size_t r_val_) const
 {
 	BigReal r_val = BigReal::to_big_real(r_val_);
 	return operator/(r_val);
 }
+#endif
 
 const BigReal BigReal::operator/(std::int64_t r_val_) const
 {
@@ -873,44 +993,379 @@ const BigReal BigReal::operator/(double r_val_) const
 
 const BigReal BigReal::operator/(const BigReal& r_val_) const
 {
-	std::size_t max_size_fp = std::max(b_fractional_part.size(), r_val_.b_fractional_part.size());
-	std::string l_val_str = to_string_unsigned_whole_part() + to_string_fractional_part(); // unsigned
-	std::string r_val_str = r_val_.to_string_unsigned_whole_part() + r_val_.to_string_fractional_part();
-	append_end_zeros(l_val_str, max_size_fp - b_fractional_part.size());
-	append_end_zeros(r_val_str, max_size_fp - r_val_.b_fractional_part.size());
-
-	BigInt l_val = BigInt::to_big_int(l_val_str);
-	BigInt r_val = BigInt::to_big_int(r_val_str);
-	BigInt res_wp = l_val / r_val; // whole part, division by zero is zero
-	BigInt rem_of_div = l_val % r_val; // division by zero is zero
-	
-	std::size_t counter_am_dig_after_com = 0U;
 	std::size_t max_am_dig_after_com = std::max(b_am_dig_after_com, r_val_.b_am_dig_after_com);
+	std::size_t am_guard = (guard_digits() == std::string::npos) ? 0U : guard_digits();
+	BigReal res = divide(*this, r_val_, max_am_dig_after_com + am_guard, start_rounding());
+	res.set_amount_digits_after_comma(max_am_dig_after_com);
+	return res;
+}
 
-	BigInt part_res_fp;
-	std::string res_fp_str; // fractional
-	while (counter_am_dig_after_com < max_am_dig_after_com && !rem_of_div.is_zero())
+BigReal BigReal::divide(const BigReal& l_val_, const BigReal& r_val_, std::size_t am_frac_, DecimalRounding mode_)
+{
+	// |l| / |r| at the last kept digit: l_coef * 10^shift / r_coef, the remainder tells the rest
+	BigReal res;
+	res.set_amount_digits_after_comma(am_frac_);
+	if (l_val_.is_zero() || r_val_.is_zero())
+		return res; // division by zero is zero
+	std::int64_t exp = -static_cast<std::int64_t>(std::min<std::size_t>(am_frac_,
+		static_cast<std::size_t>(std::numeric_limits<std::int64_t>::max())));
+	std::int64_t shift = exponent_gap(l_val_.b_exp, r_val_.b_exp); // saturated: beyond any coefficient
+	if (shift != -std::numeric_limits<std::int64_t>::max() && !add_exponents(shift, -exp, shift))
+		shift = std::numeric_limits<std::int64_t>::max();
+	if (shift == std::numeric_limits<std::int64_t>::max())
+		return res; // zero, the quotient is too large for the exponent
+	bool is_neg = l_val_.is_neg() != r_val_.is_neg();
+	bool is_small = shift < 0 && static_cast<std::size_t>(-(shift + 1)) + 1U > l_val_.b_coef.bit_length();
+	if (!is_small && short_quotient(l_val_.b_coef, r_val_.b_coef, shift, is_neg, mode_, res.b_coef))
 	{
-		rem_of_div *= 10;
-		part_res_fp = rem_of_div / r_val; // 0-9
-		rem_of_div %= r_val;
-		res_fp_str.insert(res_fp_str.length(), part_res_fp.to_string());
-		++counter_am_dig_after_com;
+		res.b_exp = res.b_coef.is_zero() ? 0 : exp;
+		return res;
 	}
-	if (res_fp_str.empty())
-		res_fp_str.push_back('0');
-	std::string res_str = res_wp.to_string() + "." + res_fp_str;
-	BigReal res = BigReal::to_big_real(res_str);
-	res.set_amount_digits_after_comma(max_am_dig_after_com);
-	if (b_is_neg == r_val_.b_is_neg)
+	BigInt quot;
+	int half = -1;
+	if (!is_small)
+	{
+		BigInt num = l_val_.b_coef;
+		BigInt den = r_val_.b_coef;
+		num.reset_neg();
+		den.reset_neg();
+		if (shift >= 0)
+			num = scaled(num, static_cast<std::size_t>(shift));
+		else
+			den = scaled(den, static_cast<std::size_t>(-(shift + 1)) + 1U);
+		BigInt rem;
+		BigInt::division_with_remainder(num, den, quot, rem);
+		if (mode_ != DecimalRounding::truncate)
+		{
+			rem <<= 1U;
+			half = (rem < den) ? -1 : ((rem == den) ? 0 : 1);
+		}
+		round_quotient(quot, half, !rem.is_zero(), is_neg, mode_);
+	} // else 2 * |l_coef| < 10^-shift <= 10^-shift * |r_coef|: below half the last digit
+	else
+		round_quotient(quot, half, true, is_neg, mode_);
+	if (is_neg)
+		quot.set_neg();
+	res.b_coef = std::move(quot);
+	res.b_exp = res.b_coef.is_zero() ? 0 : exp;
+	return res;
+}
+
+bool BigReal::short_quotient(const BigInt& l_coef_, const BigInt& r_coef_, std::int64_t shift_, bool is_neg_,
+	DecimalRounding mode_, BigInt& res_)
+{
+	// 10^shift_ = 5^shift_ * 2^shift_ joins the dividend (or the divisor if negative); both are cut to am_prec bits,
+	// the quotient is the dividend times the reciprocal of the divisor (Newton, precision doubling)
+	std::size_t am_pow = static_cast<std::size_t>((shift_ < 0) ? -shift_ : shift_);
+	std::size_t len_l = l_coef_.bit_length();
+	std::size_t len_r = r_coef_.bit_length();
+	std::int64_t am_quot_bits = static_cast<std::int64_t>(len_l) - static_cast<std::int64_t>(len_r) + 1 +
+		((shift_ >= 0) ? static_cast<std::int64_t>(am_pow * 3322U / 1000U + 1U)
+			: -static_cast<std::int64_t>(am_pow * 3321U / 1000U)); // the quotient < 2^am_quot_bits
+	std::size_t am_prec = static_cast<std::size_t>(std::max<std::int64_t>(am_quot_bits, 0)) + 48U;
+	std::size_t len_den = len_r + ((shift_ < 0) ? am_pow * 3322U / 1000U + 1U : 0U);
+	// worth it when there are bits to drop (the exact division keeps them all), or the divisor and
+	// the quotient are both long (no remainder and no 10^shift_ to build)
+	bool is_cut = len_l > am_prec + 64U || len_r > am_prec + 64U || (shift_ < 0 && len_den > am_prec + 64U);
+	bool is_long = am_prec >= 32U * BigInt::newton_threshold && 2U * len_den >= am_prec;
+	if (!is_cut && !is_long)
+		return false;
+
+	BigInt num = l_coef_;
+	BigInt den = r_coef_;
+	num.reset_neg();
+	den.reset_neg();
+	std::int64_t num_exp = 0;
+	std::int64_t den_exp = 0;
+	cut_bits(num, num_exp, am_prec);
+	cut_bits(den, den_exp, am_prec);
+	std::int64_t pow_exp = 0;
+	BigInt pow = power_high(BigInt::to_big_int(static_cast<std::uint64_t>(5U)), am_pow, am_prec, pow_exp);
+	if (shift_ >= 0)
+	{
+		num *= pow;
+		num_exp += pow_exp + shift_;
+		cut_bits(num, num_exp, am_prec);
+	}
+	else
+	{
+		den *= pow;
+		den_exp += pow_exp + static_cast<std::int64_t>(am_pow);
+		cut_bits(den, den_exp, am_prec);
+	}
+
+	// the reciprocal takes n limbs with the top bit set and is off by a unit or so of B^n
+	std::size_t n = am_prec / 32U + 2U;
+	std::size_t am_pad = 32U * n - den.bit_length();
+	den <<= am_pad;
+	den_exp -= static_cast<std::int64_t>(am_pad);
+	BigInt est = num * BigInt::reciprocal(den);
+	std::int64_t exp = num_exp - den_exp - static_cast<std::int64_t>(64U * n) + 16;
+	if (exp >= 0)
+		est <<= static_cast<std::size_t>(exp);
+	else
+		est >>= static_cast<std::size_t>(-exp);
+
+	// three cuts, the power and the reciprocal leave est within 2^-(am_prec - 4) of the quotient * 2^16
+	// (below 2^-28), the floor of the shift takes less than 1 more
+	return round_bounds(est.is_zero() ? est : est - 1, est + 2, is_neg_, mode_, res_);
+}
+
+bool BigReal::round_bounds(const BigInt& lo_, const BigInt& hi_, bool is_neg_, DecimalRounding mode_, BigInt& res_)
+{
+	BigInt quot = lo_ >> 16U;
+	BigInt step = quot << 16U;
+	if (hi_ > step + (1 << 16))
+		return false; // the kept digits are not settled
+	int half = (hi_ <= step + (1 << 15)) ? -1 : ((lo_ >= step + (1 << 15)) ? 1 : 0);
+	if (half == 0)
+		return false; // too close to the half
+	round_quotient(quot, half, true, is_neg_, mode_); // something is always dropped
+	if (is_neg_)
+		quot.set_neg();
+	res_ = std::move(quot);
+	return true;
+}
+
+
+// ----------------------------------------------------------------------------
+// roots
+
+BigReal BigReal::sqrt(const BigReal& val_, std::size_t am_frac_, DecimalRounding mode_)
+{
+	return root(val_, 2U, am_frac_, mode_);
+}
+
+BigReal BigReal::rsqrt(const BigReal& val_, std::size_t am_frac_, DecimalRounding mode_)
+{
+	// 10^am / sqrt(coef * 10^exp) = 10^k / sqrt(coef) with exp made even: the inverse root of the coefficient
+	// (of coef * 25^-k for k < 0) to a few more bits than the result, settled by the squares if that is not enough
+	if (val_.is_zero() || val_.is_neg())
+	{
+		BigReal res;
+		res.set_amount_digits_after_comma(am_frac_);
+		return res;
+	}
+	BigInt coef = val_.b_coef;
+	std::int64_t exp = val_.b_exp;
+	if (exp % 2 != 0)
+	{
+		coef = scaled(coef, 1U);
+		--exp;
+	}
+	std::int64_t k = static_cast<std::int64_t>(am_frac_) - exp / 2;
+	std::size_t am_k = static_cast<std::size_t>((k < 0) ? -k : k);
+	std::int64_t am_res_bits = ((k >= 0) ? static_cast<std::int64_t>(am_k * 3322U / 1000U + 1U)
+		: -static_cast<std::int64_t>(am_k * 3321U / 1000U)) -
+		static_cast<std::int64_t>((coef.bit_length() - 1U) / 2U) + 1; // the result < 2^am_res_bits
+	std::size_t am_prec = static_cast<std::size_t>(std::max<std::int64_t>(am_res_bits, 0)) + 80U;
+
+	// est * 2^-16 is off by less than a unit: the cuts, the power and the root are within 2^-(am_prec - 48)
+	BigInt mag = coef;
+	std::int64_t mag_exp = 0;
+	std::int64_t pow_exp = 0;
+	if (k < 0)
+	{
+		cut_bits(mag, mag_exp, am_prec + 16U);
+		mag *= power_high(BigInt::to_big_int(static_cast<std::uint64_t>(25U)), am_k, am_prec + 16U, pow_exp);
+		mag_exp += pow_exp;
+		cut_bits(mag, mag_exp, am_prec + 16U);
+		if (mag_exp % 2 != 0)
+		{
+			mag <<= 1U;
+			--mag_exp;
+		}
+	}
+	std::size_t am_scale = (mag.bit_length() + 1U) / 2U * 2U;
+	BigInt est = inverse_root(mag, am_scale, 2U, am_prec);
+	std::int64_t shift = 16 - static_cast<std::int64_t>(am_prec + am_scale / 2U) - mag_exp / 2;
+	if (k >= 0)
 	{
-		res.b_is_neg = false;
+		est *= power_high(BigInt::to_big_int(static_cast<std::uint64_t>(5U)), am_k, am_prec, pow_exp);
+		shift += pow_exp + k;
+	}
+	else
+		shift += k;
+	if (shift >= 0)
+		est <<= static_cast<std::size_t>(shift);
+	else
+		est >>= static_cast<std::size_t>(-shift);
+	BigInt quot;
+	if (round_bounds(est.is_zero() ? est : est - 1, est + 2, false, mode_, quot))
+	{
+		BigReal res;
+		res.set_amount_digits_after_comma(am_frac_);
+		res.b_exp = quot.is_zero() ? 0 : -static_cast<std::int64_t>(am_frac_);
+		res.b_coef = std::move(quot);
 		return res;
 	}
-	res.b_is_neg = !res.is_zero();
+
+	// near a rounding point: t / 2 against the result by t^2 * coef * 100^-k against 4 (4 * 100^k if k >= 0)
+	BigInt one = BigInt::to_big_int(static_cast<std::uint64_t>(1U));
+	BigInt lhs = (k < 0) ? scaled(coef, 2U * am_k) : coef;
+	BigInt rhs = ((k < 0) ? one : scaled(one, 2U * am_k)) << 2U;
+	BigInt twice = est.is_zero() ? est : (est - 1) >> 15U; // at most 2 * result
+	while ((twice + 1) * (twice + 1) * lhs <= rhs)
+		++twice;
+	bool is_exact = twice * twice * lhs == rhs;
+	return root_from_twice(std::move(twice), is_exact, am_frac_, false, mode_);
+}
+
+BigReal BigReal::cbrt(const BigReal& val_, std::size_t am_frac_, DecimalRounding mode_)
+{
+	return root(val_, 3U, am_frac_, mode_);
+}
+
+BigReal BigReal::root(const BigReal& val_, std::uint32_t n_, std::size_t am_frac_, DecimalRounding mode_)
+{
+	// |coef| * 10^(exp + n * am), the sign stays with odd roots
+	if (val_.is_zero() || n_ == 0U || (val_.is_neg() && n_ % 2U == 0U))
+	{
+		BigReal res;
+		res.set_amount_digits_after_comma(am_frac_);
+		return res;
+	}
+	std::int64_t shift = val_.b_exp + static_cast<std::int64_t>(n_) * static_cast<std::int64_t>(am_frac_);
+	BigInt mag = val_.b_coef;
+	mag.reset_neg();
+	BigInt one = BigInt::to_big_int(static_cast<std::uint64_t>(1U));
+	if (shift >= 0)
+		return root_rounded(scaled(mag, static_cast<std::size_t>(shift)), one, n_, am_frac_, val_.is_neg(), mode_);
+	return root_rounded(std::move(mag), scaled(one, static_cast<std::size_t>(-shift)), n_, am_frac_, val_.is_neg(), mode_);
+}
+
+BigReal BigReal::root_rounded(BigInt num_, const BigInt& den_, std::uint32_t n_, std::size_t am_frac_, bool is_neg_,
+	DecimalRounding mode_)
+{
+	// one bit more: floor(2 * q^(1/n)) = floor(floor(2^n * q)^(1/n)), even below the half, odd at or above it
+	BigInt whole, rem;
+	num_ <<= n_;
+	BigInt::division_with_remainder(num_, den_, whole, rem);
+	bool is_exact = false;
+	BigInt twice = integer_root(whole, n_, is_exact);
+	return root_from_twice(std::move(twice), is_exact && rem.is_zero(), am_frac_, is_neg_, mode_);
+}
+
+BigReal BigReal::root_from_twice(BigInt twice_, bool is_exact_, std::size_t am_frac_, bool is_neg_,
+	DecimalRounding mode_)
+{
+	bool is_odd = twice_.is_odd();
+	BigInt quot = twice_ >> 1U;
+	int half = !is_odd ? -1 : (is_exact_ ? 0 : 1);
+	round_quotient(quot, half, is_odd || !is_exact_, is_neg_, mode_);
+	if (is_neg_)
+		quot.set_neg();
+	BigReal res;
+	res.set_amount_digits_after_comma(am_frac_);
+	res.b_exp = quot.is_zero() ? 0 : -static_cast<std::int64_t>(am_frac_);
+	res.b_coef = std::move(quot);
 	return res;
 }
 
+BigInt BigReal::integer_root(const BigInt& val_, std::uint32_t n_, bool& is_exact_)
+{
+	// y = val^(-1/n) and x = val * y^(n - 1) to half the bits, then one Newton step for the root itself:
+	// x + y^(n - 1) * (val - x^n) / n, with am_frac bits below the unit. That step takes the place of the
+	// last step of y and of a full product val * y^(n - 1); the powers only settle estimates next to an integer
+	is_exact_ = true;
+	if (val_.is_zero() || n_ == 1U)
+		return val_;
+	const std::size_t am_frac = 32U;
+	std::size_t am_root = (val_.bit_length() + n_ - 1U) / n_; // root < 2^am_root
+	std::size_t am_prec = am_root + am_frac;
+	std::size_t am_half = am_prec / 2U + 16U;
+	// val^(-1/n) = inv * 2^-(am_half + am_root), its power pow * 2^pow_exp
+	BigInt inv = inverse_root(val_, am_root * n_, n_, am_half);
+	std::int64_t pow_exp = 0;
+	BigInt pow = power_high(inv, n_ - 1U, am_half + 16U, pow_exp);
+	pow_exp -= static_cast<std::int64_t>((n_ - 1U) * (am_half + am_root));
+	BigInt x = val_;
+	std::int64_t x_exp = 0;
+	cut_bits(x, x_exp, am_half + 16U);
+	x *= pow;
+	x_exp += pow_exp;
+	cut_bits(x, x_exp, am_half + 16U);
+	// val - x^n is about 2^-am_half of val: its leading bits are enough for the correction
+	BigInt val = val_;
+	std::int64_t val_exp = 0;
+	cut_bits(val, val_exp, am_prec + 24U);
+	std::int64_t xn_exp = 0;
+	BigInt xn = power_high(x, n_, am_prec + 24U, xn_exp);
+	xn_exp += static_cast<std::int64_t>(n_) * x_exp;
+	std::int64_t diff_exp = std::min(val_exp, xn_exp);
+	BigInt diff = (val << static_cast<std::size_t>(val_exp - diff_exp)) - (xn << static_cast<std::size_t>(xn_exp - diff_exp));
+	cut_bits(diff, diff_exp, am_prec - am_half + 40U);
+	BigInt corr = (pow * diff) / static_cast<std::size_t>(n_);
+	auto in_frac_units = [am_frac](BigInt mag_, std::int64_t exp_) {
+		exp_ += static_cast<std::int64_t>(am_frac);
+		return (exp_ >= 0) ? mag_ << static_cast<std::size_t>(exp_) : mag_ >> static_cast<std::size_t>(-exp_);
+	};
+	BigInt est = in_frac_units(std::move(x), x_exp) + in_frac_units(std::move(corr), pow_exp + diff_exp);
+	BigInt res = est >> am_frac;
+	// the estimate is within n units of 2^-am_frac and a few for the cuts: away from an integer the floor is
+	// settled and the root inexact
+	std::uint64_t frac = (est - (res << am_frac)).to_uint64();
+	std::uint64_t am_off = static_cast<std::uint64_t>(n_) + 16U;
+	if (res.is_neg())
+		res.reset();
+	else if (n_ < (1U << 24U) && frac > am_off && frac < (static_cast<std::uint64_t>(1U) << am_frac) - am_off)
+	{
+		is_exact_ = false;
+		return res;
+	}
+
+	pow = power(res, n_);
+	while (pow > val_)
+	{
+		--res;
+		pow = power(res, n_);
+	}
+	for (;;)
+	{
+		BigInt next = (n_ == 2U) ? pow + (res << 1U) + 1 : power(res + 1, n_);
+		if (next > val_)
+			break;
+		++res;
+		pow = std::move(next);
+	}
+	is_exact_ = pow == val_;
+	return res;
+}
+
+BigInt BigReal::inverse_root(const BigInt& val_, std::size_t am_scale_, std::uint32_t n_, std::size_t am_bits_)
+{
+	// y += y * (1 - a * y^n) / n from half the bits (and a few): each step doubles them,
+	// so the top one costs about as much as all the others. There y^n of the half-length y is exact
+	// up to the full length, y * err is half-length, and the product a * y^n is the one full multiply
+	// (with log2(n) - 1 full squarings in y^n for n > 3): 1 - a * y^n needs every bit of it.
+	// Roots rather than inverses stop y at half the bits, see integer_root()
+	if (am_bits_ <= 48U)
+	{
+		// by logarithms, a may be below the double range for large n
+		std::size_t am_drop = (val_.bit_length() > 53U) ? val_.bit_length() - 53U : 0U;
+		double log_a = std::log2(static_cast<double>((val_ >> am_drop).to_uint64())) +
+			static_cast<double>(static_cast<std::int64_t>(am_drop) - static_cast<std::int64_t>(am_scale_));
+		double y = std::exp2(-log_a / static_cast<double>(n_)); // 1 < y <= 2
+		return BigInt::to_big_int(static_cast<std::uint64_t>(std::ldexp(y, static_cast<int>(am_bits_))));
+	}
+	std::size_t am_half = am_bits_ / 2U + 16U;
+	BigInt half_inv = inverse_root(val_, am_scale_, n_, am_half);
+	// a * y^n = val * pow / 2^am_one, near 1
+	BigInt val = val_;
+	std::int64_t val_exp = 0;
+	std::int64_t pow_exp = 0;
+	cut_bits(val, val_exp, am_bits_ + 16U);
+	BigInt prod = val * power_high(half_inv, n_, am_bits_ + 16U, pow_exp);
+	std::int64_t am_one = static_cast<std::int64_t>(am_scale_ + n_ * am_half) - val_exp - pow_exp;
+	// 1 - a * y^n is about 2^-am_half: its leading bits are enough for the correction
+	BigInt err = (BigInt::to_big_int(static_cast<std::uint64_t>(1U)) << static_cast<std::size_t>(am_one)) - prod;
+	std::int64_t err_exp = 0;
+	cut_bits(err, err_exp, am_bits_ - am_half + 32U);
+	BigInt res = half_inv << (am_bits_ - am_half);
+	res += ((half_inv * err) >> static_cast<std::size_t>(am_one - err_exp + static_cast<std::int64_t>(am_half) -
+		static_cast<std::int64_t>(am_bits_))) / static_cast<std::size_t>(n_);
+	return res;
+}
 
 // ----------------------------------------------------------------------------
 // arithmetic %
@@ -920,11 +1375,13 @@ const BigReal BigReal::operator%(std::int32_t r_val_) const
 	return operator%(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigReal BigReal::operator%(std::size_t r_val_) const
 {
 	BigReal r_val = BigReal::to_big_real(r_val_);
 	return operator%(r_val);
 }
+#endif
 
 const BigReal BigReal::operator%(std::int64_t r_val_) const
 {
@@ -959,8 +1416,16 @@ const BigReal BigReal::operator%(double r_val_) const
 const BigReal BigReal::operator%(const BigReal& r_val_) const
 {
 	BigReal gen_res = operator/(r_val_); // if r_val_ is neg, then ge_res will be neg, division by zero is zero
-	gen_res.b_whole_part.clear();
-	gen_res.b_whole_part.push_back(static_cast<std::int8_t>(0)); // set zero
+	if (gen_res.b_exp >= 0)
+		gen_res.b_coef.reset(); // no fractional part
+	else
+	{
+		bool is_neg = gen_res.b_coef.is_neg();
+		gen_res.b_coef.reset_neg();
+		gen_res.b_coef %= power(10U, static_cast<std::size_t>(-(gen_res.b_exp + 1)) + 1U); // drop the whole part
+		if (is_neg)
+			gen_res.b_coef.set_neg();
+	}
 	gen_res *= r_val_; // close to the remainder...
 	return gen_res; // nrvo
 }
@@ -974,11 +1439,13 @@ BigReal& BigReal::operator*=(std::int32_t r_val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigReal& BigReal::operator*=(std::size_t r_val_)
 {
 	*this = this->operator*(r_val_);
 	return *this;
 }
+#endif
 
 BigReal& BigReal::operator*=(std::int64_t r_val_)
 {
@@ -1022,11 +1489,13 @@ BigReal& BigReal::operator/=(std::int32_t r_val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigReal& BigReal::operator/=(std::size_t r_val_)
 {
 	*this = this->operator/(r_val_);
 	return *this;
 }
+#endif
 
 BigReal& BigReal::operator/=(std::int64_t r_val_)
 {
@@ -1070,11 +1539,13 @@ BigReal& BigReal::operator%=(std::int32_t r_val_)
 	return *this;
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigReal& BigReal::operator%=(std::size_t r_val_)
 {
 	*this = this->operator%(r_val_);
 	return *this;
 }
+#endif
 
 BigReal& BigReal::operator%=(std::int64_t r_val_)
 {
@@ -1120,10 +1591,12 @@ const BigReal operator*(std::int32_t l_val_, const BigReal& r_val_)
 	return r_val_.operator*(l_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigReal operator*(std::size_t l_val_, const BigReal& r_val_)
 {
 	return r_val_.operator*(l_val_);
 }
+#endif
 
 const BigReal operator*(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -1159,11 +1632,13 @@ const BigReal operator/(std::int32_t l_val_, const BigReal& r_val_)
 	return l_val.operator/(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigReal operator/(std::size_t l_val_, const BigReal& r_val_)
 {
 	BigReal l_val = BigReal::to_big_real(l_val_);
 	return l_val.operator/(r_val_);
 }
+#endif
 
 const BigReal operator/(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -1204,11 +1679,13 @@ const BigReal operator%(std::int32_t l_val_, const BigReal& r_val_)
 	return l_val.operator%(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 const BigReal operator%(std::size_t l_val_, const BigReal& r_val_)
 {
 	BigReal l_val = BigReal::to_big_real(l_val_);
 	return l_val.operator%(r_val_);
 }
+#endif
 
 const BigReal operator%(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -1249,11 +1726,13 @@ bool BigReal::operator>(std::int32_t r_val_) const
 	return operator>(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigReal::operator>(std::size_t r_val_) const
 {
 	BigReal r_val = to_big_real(r_val_);
 	return operator>(r_val);
 }
+#endif
 
 bool BigReal::operator>(std::int64_t r_val_) const
 {
@@ -1287,75 +1766,52 @@ bool BigReal::operator>(double r_val_) const
 
 bool BigReal::operator>(const BigReal& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	if (is_neg_l && !is_neg_r)
-		return false;
-	if (!is_neg_l && is_neg_r)
-		return true;
-	if (this->operator==(r_val_))
-		return false;
-	if (!is_neg_l && !is_neg_r)
-		return logical_more(*this, r_val_);
-	return !logical_more(*this, r_val_);
-}
-
-bool BigReal::logical_more(const BigReal& l_val_, const BigReal& r_val_)
-{
-	bool is_mr_wp = logical_more_whole_part(l_val_, r_val_);
-	bool is_eq_wp = logical_equal_whole_part(l_val_, r_val_);
-	if (!is_mr_wp && is_eq_wp)
-		return logical_more_fractional_part(l_val_, r_val_);
-	return is_mr_wp;
-}
-
-bool BigReal::logical_more_whole_part(const BigReal& l_val_, const BigReal& r_val_)
-{
-	if (l_val_.amount_places_whole_part() > r_val_.amount_places_whole_part())
-		return true;
-	if (l_val_.amount_places_whole_part() < r_val_.amount_places_whole_part())
-		return false;
-	bool is_more = false;
-	std::size_t r_i = l_val_.amount_places_whole_part() - 1U;
-	for (std::size_t i = 0U; i < l_val_.amount_places_whole_part(); ++i, --r_i)
-		if (l_val_.b_whole_part[r_i] > r_val_.b_whole_part[r_i])
-			is_more = true;
-		else if (l_val_.b_whole_part[r_i] < r_val_.b_whole_part[r_i])
-			is_more = false;
-	return is_more;
-}
-
-bool BigReal::logical_more_fractional_part(const BigReal& l_val_, const BigReal& r_val_)
-{
-	std::string l_val_fp = l_val_.to_string_fractional_part();
-	std::string r_val_fp = r_val_.to_string_fractional_part();
-	std::size_t gen_ap_wp = (l_val_fp.length() >= r_val_fp.length()) ?
-		l_val_fp.length() : r_val_fp.length();
-	append_end_zeros_by_general_size(l_val_fp, r_val_fp);
-	bool is_more = false;
-	std::size_t r_i = gen_ap_wp - 1U;
-	for (std::size_t i = 0U; i < gen_ap_wp; ++i, --r_i)
-		if (l_val_fp[r_i] > r_val_fp[r_i])
-			is_more = true;
-		else if (l_val_fp[r_i] < r_val_fp[r_i])
-			is_more = false;
-	return is_more;
+	return compare(*this, r_val_) > 0;
 }
 
 
 // ----------------------------------------------------------------------------
 // less
+int BigReal::compare(const BigReal& l_val_, const BigReal& r_val_)
+{
+	// signs first, then the magnitudes from the exponents and the bit lengths, the coefficients at the smaller
+	// scale last
+	int sign_l = l_val_.is_zero() ? 0 : (l_val_.is_neg() ? -1 : 1);
+	int sign_r = r_val_.is_zero() ? 0 : (r_val_.is_neg() ? -1 : 1);
+	if (sign_l != sign_r)
+		return sign_l < sign_r ? -1 : 1;
+	if (sign_l == 0)
+		return 0;
+	// 10^(exp + digits_low) <= |val| < 10^(exp + digits_high), apart: the shift below is bounded by the digits
+	std::int64_t gap = exponent_gap(l_val_.b_exp, r_val_.b_exp);
+	if (gap <= digits_low(r_val_.b_coef) - digits_high(l_val_.b_coef))
+		return -sign_l;
+	if (-gap <= digits_low(l_val_.b_coef) - digits_high(r_val_.b_coef))
+		return sign_l;
+	if (l_val_.b_exp == r_val_.b_exp)
+		return l_val_.b_coef < r_val_.b_coef ? -1 : (l_val_.b_coef == r_val_.b_coef ? 0 : 1);
+	if (l_val_.b_exp < r_val_.b_exp)
+	{
+		BigInt r_coef = scaled(r_val_.b_coef, static_cast<std::size_t>(r_val_.b_exp - l_val_.b_exp));
+		return l_val_.b_coef < r_coef ? -1 : (l_val_.b_coef == r_coef ? 0 : 1);
+	}
+	BigInt l_coef = scaled(l_val_.b_coef, static_cast<std::size_t>(l_val_.b_exp - r_val_.b_exp));
+	return l_coef < r_val_.b_coef ? -1 : (l_coef == r_val_.b_coef ? 0 : 1);
+}
+
 bool BigReal::operator<(std::int32_t r_val_) const
 {
 	BigReal r_val = to_big_real(r_val_);
 	return operator<(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigReal::operator<(std::size_t r_val_) const
 {
 	BigReal r_val = to_big_real(r_val_);
 	return operator<(r_val);
 }
+#endif
 
 bool BigReal::operator<(std::int64_t r_val_) const
 {
@@ -1389,59 +1845,7 @@ bool BigReal::operator<(double r_val_) const
 
 bool BigReal::operator<(const BigReal& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	if (is_neg_l && !is_neg_r)
-		return true;
-	if (!is_neg_l && is_neg_r)
-		return false;
-	if (this->operator==(r_val_))
-		return false;
-	if (!is_neg_l && !is_neg_r)
-		return logical_less(*this, r_val_);
-	return !logical_less(*this, r_val_);
-}
-
-bool BigReal::logical_less(BigReal l_val_, BigReal r_val_)
-{
-	bool is_ls_wp = logical_less_whole_part(l_val_, r_val_);
-	bool is_eq_wp = logical_equal_whole_part(l_val_, r_val_);
-	if (!is_ls_wp && is_eq_wp)
-		return logical_less_fractional_part(l_val_, r_val_);
-	return is_ls_wp;
-}
-
-bool BigReal::logical_less_whole_part(BigReal l_val_, BigReal r_val_)
-{
-	if (l_val_.amount_places_whole_part() > r_val_.amount_places_whole_part())
-		return false;
-	if (l_val_.amount_places_whole_part() < r_val_.amount_places_whole_part())
-		return true;
-	bool is_less = false;
-	std::size_t r_i = l_val_.amount_places_whole_part() - 1U;
-	for (std::size_t i = 0U; i < l_val_.amount_places_whole_part(); ++i, --r_i)
-		if (l_val_.b_whole_part[r_i] < r_val_.b_whole_part[r_i])
-			is_less = true;
-		else if (l_val_.b_whole_part[r_i] > r_val_.b_whole_part[r_i])
-			is_less = false;
-	return is_less;
-}
-
-bool BigReal::logical_less_fractional_part(BigReal l_val_, BigReal r_val_)
-{
-	std::string l_val_fp = l_val_.to_string_fractional_part();
-	std::string r_val_fp = r_val_.to_string_fractional_part();
-	std::size_t gen_ap_wp = (l_val_fp.length() >= r_val_fp.length()) ?
-		l_val_fp.length() : r_val_fp.length();
-	append_end_zeros_by_general_size(l_val_fp, r_val_fp);
-	bool is_less = false;
-	std::size_t r_i = gen_ap_wp - 1U;
-	for (std::size_t i = 0U; i < gen_ap_wp; ++i, --r_i)
-		if (l_val_fp[r_i] < r_val_fp[r_i])
-			is_less = true;
-		else if (l_val_fp[r_i] > r_val_fp[r_i])
-			is_less = false;
-	return is_less;
+	return compare(*this, r_val_) < 0;
 }
 
 
@@ -1452,10 +1856,12 @@ bool BigReal::operator>=(std::int32_t r_val_) const
 	return !operator<(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigReal::operator>=(std::size_t r_val_) const
 {
 	return !operator<(r_val_);
 }
+#endif
 
 bool BigReal::operator>=(std::int64_t r_val_) const
 {
@@ -1492,10 +1898,12 @@ bool BigReal::operator<=(std::int32_t r_val_) const
 	return !operator>(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigReal::operator<=(std::size_t r_val_) const
 {
 	return !operator>(r_val_);
 }
+#endif
 
 bool BigReal::operator<=(std::int64_t r_val_) const
 {
@@ -1536,11 +1944,13 @@ bool BigReal::operator==(std::int32_t r_val_) const
 	return operator==(r_val);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigReal::operator==(std::size_t r_val_) const
 {
 	BigReal r_val = to_big_real(r_val_);
 	return operator==(r_val);
 }
+#endif
 
 bool BigReal::operator==(std::int64_t r_val_) const
 {
@@ -1574,44 +1984,7 @@ bool BigReal::operator==(double r_val_) const
 
 bool BigReal::operator==(const BigReal& r_val_) const
 {
-	bool is_neg_l = b_is_neg;
-	bool is_neg_r = r_val_.b_is_neg;
-	if (is_neg_l && !is_neg_r)
-		return false;
-	if (!is_neg_l && is_neg_r)
-		return false;
-	return logical_equal(*this, r_val_);
-}
-
-bool BigReal::logical_equal(const BigReal& l_val_, const BigReal& r_val_) // positive
-{
-	bool eq_wp = logical_equal_whole_part(l_val_, r_val_);
-	bool eq_fp = logical_equal_fractional_part(l_val_, r_val_);
-	return eq_wp && eq_fp;
-}
-
-bool BigReal::logical_equal_whole_part(const BigReal& l_val_, const BigReal& r_val_)
-{
-	if (l_val_.amount_places_whole_part() != r_val_.amount_places_whole_part())
-		return false;
-	bool is_equal = true;
-	std::size_t r_i = l_val_.b_whole_part.size() - 1U;
-	for (std::size_t i = 0U; is_equal && i < l_val_.b_whole_part.size(); ++i, --r_i)
-		if (l_val_.b_whole_part[r_i] != r_val_.b_whole_part[r_i])
-			is_equal = false;
-	return is_equal;
-}
-
-bool BigReal::logical_equal_fractional_part(const BigReal& l_val_, const BigReal& r_val_)
-{
-	if (l_val_.amount_places_fractional_part() != r_val_.amount_places_fractional_part())
-		return false;
-	bool is_equal = true;
-	std::size_t r_i = l_val_.b_fractional_part.size() - 1U;
-	for (std::size_t i = 0U; is_equal && i < l_val_.b_fractional_part.size(); ++i, --r_i)
-		if (l_val_.b_fractional_part[r_i] != r_val_.b_fractional_part[r_i])
-			is_equal = false;
-	return is_equal;
+	return compare(*this, r_val_) == 0;
 }
 
 bool BigReal::operator!=(std::int32_t r_val_) const
@@ -1619,10 +1992,12 @@ bool BigReal::operator!=(std::int32_t r_val_) const
 	return !operator==(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool BigReal::operator!=(std::size_t r_val_) const
 {
 	return !operator==(r_val_);
 }
+#endif
 
 bool BigReal::operator!=(std::int64_t r_val_) const
 {
@@ -1663,11 +2038,13 @@ bool operator>(std::int32_t l_val_, const BigReal& r_val_)
 	return l_val.operator>(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator>(std::size_t l_val_, const BigReal& r_val_)
 {
 	BigReal l_val = BigReal::to_big_real(l_val_);
 	return l_val.operator>(r_val_);
 }
+#endif
 
 bool operator>(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -1705,11 +2082,13 @@ bool operator<(std::int32_t l_val_, const BigReal& r_val_)
 	return l_val.operator<(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator<(std::size_t l_val_, const BigReal& r_val_)
 {
 	BigReal l_val = BigReal::to_big_real(l_val_);
 	return l_val.operator<(r_val_);
 }
+#endif
 
 bool operator<(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -1747,11 +2126,13 @@ bool operator>=(std::int32_t l_val_, const BigReal& r_val_)
 	return l_val.operator>=(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator>=(std::size_t l_val_, const BigReal& r_val_)
 {
 	BigReal l_val = BigReal::to_big_real(l_val_);
 	return l_val.operator>=(r_val_);
 }
+#endif
 
 bool operator>=(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -1789,11 +2170,13 @@ bool operator<=(std::int32_t l_val_, const BigReal& r_val_)
 	return l_val.operator<=(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator<=(std::size_t l_val_, const BigReal& r_val_)
 {
 	BigReal l_val = BigReal::to_big_real(l_val_);
 	return l_val.operator<=(r_val_);
 }
+#endif
 
 bool operator<=(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -1831,11 +2214,13 @@ bool operator==(std::int32_t l_val_, const BigReal& r_val_)
 	return l_val.operator==(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator==(std::size_t l_val_, const BigReal& r_val_)
 {
 	BigReal l_val = BigReal::to_big_real(l_val_);
 	return l_val.operator==(r_val_);
 }
+#endif
 
 bool operator==(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -1873,11 +2258,13 @@ bool operator!=(std::int32_t l_val_, const BigReal& r_val_)
 	return l_val.operator!=(r_val_);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 bool operator!=(std::size_t l_val_, const BigReal& r_val_)
 {
 	BigReal l_val = BigReal::to_big_real(l_val_);
 	return l_val.operator!=(r_val_);
 }
+#endif
 
 bool operator!=(std::int64_t l_val_, const BigReal& r_val_)
 {
@@ -1912,6 +2299,85 @@ bool operator!=(double l_val_, const BigReal& r_val_)
 
 // ----------------------------------------------------------------------------
 // amount digits after comma
+BigReal BigReal::rounded(std::size_t am_frac_, DecimalRounding mode_) const
+{
+	BigReal res(*this);
+	std::int64_t exp_to = -static_cast<std::int64_t>(am_frac_);
+	if (res.b_exp < exp_to)
+	{
+		bool is_neg = res.is_neg();
+		res.b_coef.reset_neg();
+		round_coef(res.b_coef, res.b_exp, exp_to, is_neg, false, mode_);
+	}
+	return res;
+}
+
+void BigReal::bound()
+{
+	if (guard_digits() != std::string::npos && b_exp < -static_cast<std::int64_t>(bounded_digits()))
+		*this = rounded(bounded_digits(), start_rounding());
+}
+
+std::size_t BigReal::bounded_digits() const
+{
+	return b_am_dig_after_com + std::min(guard_digits(), std::string::npos - b_am_dig_after_com);
+}
+
+void BigReal::round_coef(BigInt& mag_, std::int64_t& exp_, std::int64_t exp_to_, bool is_neg_, bool is_sticky_,
+	DecimalRounding mode_)
+{
+	if (exp_ < exp_to_)
+	{
+		std::size_t am_drop = static_cast<std::size_t>(exp_to_ - exp_);
+		int half = -1; // dropped part against half a unit of the last kept digit
+		bool is_rest = is_sticky_;
+		if (am_drop > mag_.bit_length() + 1U) // 2 * mag_ < 2^am_drop < 10^am_drop
+		{
+			is_rest = is_rest || !mag_.is_zero();
+			mag_.reset();
+		}
+		else
+		{
+			BigInt unit = scaled(BigInt::to_big_int(1), am_drop);
+			BigInt quot = mag_ / unit;
+			BigInt twice_rem = (mag_ - quot * unit) << 1U;
+			half = twice_rem < unit ? -1 : (twice_rem == unit ? (is_sticky_ ? 1 : 0) : 1);
+			is_rest = is_rest || !twice_rem.is_zero();
+			mag_ = std::move(quot);
+		}
+		round_quotient(mag_, half, is_rest, is_neg_, mode_);
+		exp_ = exp_to_;
+	}
+	if (is_neg_)
+		mag_.set_neg();
+	if (mag_.is_zero())
+		exp_ = 0;
+}
+
+void BigReal::round_quotient(BigInt& quot_, int half_, bool is_rest_, bool is_neg_, DecimalRounding mode_)
+{
+	bool is_away = false; // from zero
+	switch (mode_)
+	{
+	case DecimalRounding::half_even:
+		is_away = half_ > 0 || (half_ == 0 && quot_.is_odd());
+		break;
+	case DecimalRounding::half_up:
+		is_away = half_ >= 0;
+		break;
+	case DecimalRounding::floor:
+		is_away = is_neg_ && is_rest_;
+		break;
+	case DecimalRounding::ceil:
+		is_away = !is_neg_ && is_rest_;
+		break;
+	case DecimalRounding::truncate:
+		break;
+	}
+	if (is_away)
+		quot_ += 1;
+}
+
 std::size_t BigReal::get_amount_digits_after_comma() const
 {
 	return b_am_dig_after_com;
@@ -1927,334 +2393,429 @@ void BigReal::set_amount_digits_after_comma(std::size_t am_dig_after_com_)
 // stream
 std::istream& BigReal::operator>>(std::istream& stream_)
 {
-	// idea
-	std::string str;
-	std::size_t st_p = 0U;
-	char if_there_is_sign_then_it_is_sign = static_cast<char>(0);
-	stream_ >> str;
-	if (str[0] == '-' || str[0] == '+')
-	{
-		st_p = 1U;
-		if_there_is_sign_then_it_is_sign = str[0];
-	}
-	*this = read_big_real(str, st_p);
-	if (if_there_is_sign_then_it_is_sign == '-')
-		b_is_neg = !is_zero();
+	BigRealParser parser; // no copy of the token
+	parser.read(stream_);
+	if (!parser.finish(*this))
+		reset();
 	return stream_;
 }
 
 BigReal BigReal::read_big_real(const std::string& str_, std::size_t st_p_)
 {
 	BigReal br;
-	std::size_t last_digit_wp_p = st_p_;
-	bool is_comma = false;
-	for (; last_digit_wp_p < str_.length(); ++last_digit_wp_p)
-		if (str_[last_digit_wp_p] < '0' || str_[last_digit_wp_p] > '9')
-			break;
-	if (st_p_ == last_digit_wp_p && str_[last_digit_wp_p] != '.')
+	if (st_p_ >= str_.length())
 		return br; // default
-	if (st_p_ != last_digit_wp_p) // str_[last_digit_p] == '.' || str_[last_digit_p] != '.'
-	{
-		br.b_whole_part.clear();
-		br.b_whole_part.reserve(last_digit_wp_p - st_p_ + 1U);
-		for (std::size_t i = st_p_; i < last_digit_wp_p; ++i)
-			br.b_whole_part.push_back(static_cast<std::int8_t>(str_[i] - '0'));
-		remove_leading_zeros_from_whole_part(br); // ref
-	}
-	if (str_[last_digit_wp_p] != '.') // st_p_ != last_digit_p (up), only whole
-		return br; 
-	// st_p_ == last_digit_p
-	++last_digit_wp_p; // skip comma
-	std::size_t last_digit_fp_p = last_digit_wp_p;
-	for (; last_digit_fp_p < str_.length(); ++last_digit_fp_p)
-		if (str_[last_digit_fp_p] < '0' || str_[last_digit_fp_p] > '9')
-			break;
-	br.b_fractional_part.clear();
-	br.b_fractional_part.reserve(last_digit_fp_p - last_digit_wp_p + 1U);
-	for (std::size_t i = last_digit_wp_p; i < last_digit_fp_p; ++i)
-		br.b_fractional_part.push_back(static_cast<std::int8_t>(str_[i] - '0')); // cp
-	remove_end_zeros_from_fractional_part(br);
+	if (from_chars(str_.data() + st_p_, str_.data() + str_.length(), br).ec != std::errc())
+		br.reset();
 	return br;
 }
 
 std::ostream& BigReal::operator<<(std::ostream& stream_) const
 {
-	stream_ << to_string();
+	// big values go out in chunks, padding needs the whole text
+	if (stream_.width() != 0 || b_coef.bit_length() < 65536U * 3U) // about 59000 digits
+		return stream_ << to_string();
+	StreamWriter wr(stream_);
+	wr.write(*this);
 	return stream_;
 }
 
 std::string BigReal::to_string() const
 {
-	std::stringstream ss;
-	if (b_is_neg)
-		ss << '-';
-	for (std::size_t i = 0; i < b_whole_part.size(); ++i)
-		ss << static_cast<std::int32_t>(b_whole_part[i]);
-	if (b_fractional_part.empty())
-		return ss.str();
-	if (b_am_dig_after_com != 0U) // limit
-	{
-		ss << '.';
-		for (std::size_t i = 0; i < b_am_dig_after_com && i < b_fractional_part.size(); ++i)
-			ss << static_cast<std::int32_t>(b_fractional_part[i]);
-	}
-	return ss.str();
+	std::string str;
+	write_text(*this, [&str](const char* data_, std::size_t size_) {
+		str.append(data_, size_);
+		return true;
+	});
+	return str;
 }
 
 std::string BigReal::to_string_unsigned() const
 {
-	std::stringstream ss;
-	for (std::size_t i = 0; i < b_whole_part.size(); ++i)
-		ss << static_cast<std::int32_t>(b_whole_part[i]);
-	if (b_fractional_part.empty())
-		return ss.str();
-	if (b_am_dig_after_com != 0U)
-	{
-		ss << '.';
-		for (std::size_t i = 0; i < b_am_dig_after_com && i < b_fractional_part.size(); ++i)
-			ss << static_cast<std::int32_t>(b_fractional_part[i]);
-	}
-	return ss.str();
+	std::string str = to_string();
+	if (is_neg())
+		str.erase(0U, 1U);
+	return str;
 }
 
 std::string BigReal::to_string_whole_part() const
 {
-	std::stringstream ss;
-	if (b_is_neg)
-		ss << '-';
-	for (std::size_t i = 0; i < b_whole_part.size(); ++i)
-		ss << static_cast<std::int32_t>(b_whole_part[i]);
-	return ss.str();
+	std::string whole, frac;
+	split_digits(whole, frac, 0U);
+	if (is_neg())
+		whole.insert(0U, 1U, '-');
+	return whole;
 }
 
 std::string BigReal::to_string_unsigned_whole_part() const
 {
-	std::stringstream ss;
-	for (std::size_t i = 0; i < b_whole_part.size(); ++i)
-		ss << static_cast<std::int32_t>(b_whole_part[i]);
-	return ss.str();
+	std::string whole, frac;
+	split_digits(whole, frac, 0U);
+	return whole;
 }
 
 std::string BigReal::to_string_fractional_part() const
 {
-	std::stringstream ss;
-	for (std::size_t i = 0; i < b_fractional_part.size(); ++i)
-		ss << static_cast<std::int32_t>(b_fractional_part[i]);
-	return ss.str();
+	std::string whole, frac;
+	split_digits(whole, frac, std::numeric_limits<std::size_t>::max());
+	return frac.empty() ? std::string("0") : frac;
 }
 
-std::istream& operator>>(std::istream& stream_, BigReal& bi_)
+std::string BigReal::to_string_scientific(std::size_t digits_) const
 {
-	return bi_.operator>>(stream_);
+	std::int64_t exp10 = 0;
+	std::string digs = significant_digits(std::max<std::size_t>(digits_, 1U), exp10);
+	std::string str(is_neg() ? 1U : 0U, '-');
+	str.push_back(digs.front());
+	if (digs.length() > 1U)
+	{
+		str.push_back('.');
+		str.append(digs, 1U, std::string::npos);
+	}
+	str.push_back('e');
+	str.append(std::to_string(exp10));
+	return str;
+}
+
+std::string BigReal::to_string_engineering(std::size_t digits_) const
+{
+	std::int64_t exp10 = 0;
+	std::string digs = significant_digits(std::max<std::size_t>(digits_, 1U), exp10);
+	std::int64_t eng_exp10 = (exp10 >= 0) ? exp10 / 3 * 3 : -((2 - exp10) / 3 * 3);
+	std::size_t am_lead = static_cast<std::size_t>(exp10 - eng_exp10) + 1U; // 1..3
+	if (digs.length() < am_lead)
+		digs.append(am_lead - digs.length(), '0');
+	std::string str(is_neg() ? 1U : 0U, '-');
+	str.append(digs, 0U, am_lead);
+	if (digs.length() > am_lead)
+	{
+		str.push_back('.');
+		str.append(digs, am_lead, std::string::npos);
+	}
+	str.push_back('e');
+	str.append(std::to_string(eng_exp10));
+	return str;
 }
 
-std::ostream& operator<<(std::ostream& stream_, const BigReal& bi_)
+std::string BigReal::significant_digits(std::size_t am_, std::int64_t& exp10_) const
 {
-	return bi_.operator<<(stream_);
+	std::string digs(am_, '0');
+	exp10_ = 0;
+	if (is_zero())
+		return digs;
+	std::string all = b_coef.to_string_unsigned();
+	exp10_ = b_exp + static_cast<std::int64_t>(all.length()) - 1;
+	all.copy(&digs[0], std::min(am_, all.length()));
+	return digs;
 }
 
+bool BigReal::write_text(const BigReal& val_, const std::function<bool(const char*, std::size_t)>& out_)
+{
+	if (val_.b_exp < -static_cast<std::int64_t>(val_.b_am_dig_after_com)) // the dropped digits are never written
+		return write_text(val_.rounded(val_.b_am_dig_after_com, start_rounding()), out_);
+	if (val_.is_neg() && !out_("-", 1U))
+		return false;
+	if (val_.b_exp > 0 && static_cast<std::uint64_t>(val_.b_exp) > exponent_zeros_limit() && !val_.is_zero())
+	{
+		// d.ddd e exp10 as in split_digits(), ddd e exp if exp10 is beyond int64
+		std::int64_t exp10 = 0;
+		bool is_exp10 = add_exponents(val_.b_exp, static_cast<std::int64_t>(decimal_length(val_.b_coef) - 1U), exp10);
+		bool is_first = is_exp10;
+		if (!BigInt::write_decimal(val_.b_coef, [&out_, &is_first](const char* data_, std::size_t size_) {
+			if (!is_first)
+				return out_(data_, size_);
+			is_first = false;
+			return out_(data_, 1U) && (size_ == 1U || (out_(".", 1U) && out_(data_ + 1U, size_ - 1U)));
+		}))
+			return false;
+		std::string exp = "e" + std::to_string(is_exp10 ? exp10 : val_.b_exp);
+		return out_(exp.data(), exp.length());
+	}
+	if (val_.b_exp >= 0 || val_.is_zero())
+	{
+		// integer: the coefficient, then the zeros of the scale
+		if (!BigInt::write_decimal(val_.b_coef, out_)
+			|| (!val_.is_zero() && !write_zeros(static_cast<std::size_t>(val_.b_exp), out_)))
+			return false;
+		return val_.b_am_dig_after_com == 0U || out_(".0", 2U);
+	}
+	// the last am_frac digits are fractional, their zeros wait for a nonzero digit (trailing ones are dropped)
+	std::size_t am_frac = static_cast<std::size_t>(-(val_.b_exp + 1)) + 1U;
+	std::size_t am_digs = decimal_length(val_.b_coef);
+	std::size_t am_whole = (am_digs > am_frac) ? am_digs - am_frac : 0U;
+	std::size_t am_zeros = (am_digs > am_frac) ? 0U : am_frac - am_digs;
+	bool is_frac = false; // a fractional digit is written
+	if (am_whole == 0U && !out_("0.", 2U))
+		return false;
+	if (!BigInt::write_decimal(val_.b_coef, [&](const char* data_, std::size_t size_) {
+		if (am_whole != 0U)
+		{
+			std::size_t len = std::min(am_whole, size_);
+			am_whole -= len;
+			if (!out_(data_, len) || (am_whole == 0U && !out_(".", 1U)))
+				return false;
+			data_ += len;
+			size_ -= len;
+		}
+		const char* last = data_ + size_;
+		while (last != data_ && *(last - 1) == '0')
+			--last;
+		if (last == data_)
+		{
+			am_zeros += size_;
+			return true;
+		}
+		if (!write_zeros(am_zeros, out_) || !out_(data_, static_cast<std::size_t>(last - data_)))
+			return false;
+		is_frac = true;
+		am_zeros = static_cast<std::size_t>(data_ + size_ - last);
+		return true;
+	}))
+		return false;
+	return is_frac || out_("0", 1U);
+}
 
-// ----------------------------------------------------------------------------
-// to big real from str
-BigReal BigReal::to_big_real(const std::string& str_)
+bool BigReal::write_zeros(std::size_t am_, const std::function<bool(const char*, std::size_t)>& out_)
 {
-	BigReal br;
-	to_big_real(br, str_);
-	return br;
+	static const std::string zeros(256U, '0');
+	while (am_ != 0U)
+	{
+		std::size_t len = std::min(zeros.length(), am_);
+		if (!out_(zeros.data(), len))
+			return false;
+		am_ -= len;
+	}
+	return true;
 }
 
-void BigReal::to_big_real(BigReal &br_, const std::string& str_) // without check
+void BigReal::split_digits(std::string& whole_, std::string& frac_, std::size_t am_frac_) const
 {
-	if (str_.empty())
+	std::string digs = b_coef.to_string_unsigned(); // cached for big values, see BigInt::decimal_cache_limbs()
+	frac_.clear();
+	if (b_exp > 0 && static_cast<std::uint64_t>(b_exp) > exponent_zeros_limit() && !is_zero())
 	{
-		br_ = BigReal();
+		// to_string_scientific() with every digit, from_chars reads it back
+		std::int64_t exp10 = 0;
+		if (!add_exponents(b_exp, static_cast<std::int64_t>(digs.length() - 1U), exp10))
+		{
+			whole_ = std::move(digs); // its leading exponent is beyond int64: ddd e exp instead
+			whole_.append(1U, 'e').append(std::to_string(b_exp));
+			return;
+		}
+		whole_.assign(digs, 0U, 1U);
+		if (digs.length() > 1U)
+			whole_.append(1U, '.').append(digs, 1U, std::string::npos);
+		whole_.append(1U, 'e').append(std::to_string(exp10));
 		return;
 	}
-	std::size_t offset = 0U;
-	if (str_.front() == '-')
+	if (b_exp >= 0 || is_zero())
 	{
-		br_.b_is_neg = true;
-		++offset;
+		whole_ = std::move(digs);
+		if (!is_zero())
+			whole_.append(static_cast<std::size_t>(b_exp), '0');
 	}
-	std::size_t pos_com = str_.length();
-	std::size_t pos_after_com = str_.length();
-	for (std::size_t i = offset; i < str_.length(); ++i)
+	else
 	{
-		if (str_[i] == '.')
+		std::size_t am_frac = static_cast<std::size_t>(-(b_exp + 1)) + 1U;
+		std::size_t am_end_zeros = 0U; // of the fractional part
+		while (am_end_zeros < am_frac && digs[digs.length() - 1U - am_end_zeros] == '0')
+			++am_end_zeros;
+		if (digs.length() > am_frac)
 		{
-			pos_com = i;
-			pos_after_com = i + 1;
-			break;
+			whole_.assign(digs, 0U, digs.length() - am_frac);
+			frac_.assign(digs, digs.length() - am_frac, std::min(am_frac - am_end_zeros, am_frac_));
+		}
+		else
+		{
+			std::size_t am_lead_zeros = am_frac - digs.length();
+			whole_ = "0";
+			frac_.assign(std::min(am_lead_zeros, am_frac_), '0');
+			if (am_frac_ > am_lead_zeros)
+				frac_.append(digs, 0U, std::min(am_frac_ - am_lead_zeros, digs.length() - am_end_zeros));
 		}
 	}
-	// sign is already set
-	to_big_real_whole_part(br_, str_.substr(offset, pos_com - offset));
-	to_big_real_fractional_part(br_, str_.substr(pos_after_com)); // if is (min value zero)
+	if (frac_.empty())
+		frac_ = "0";
 }
 
-void BigReal::to_big_real_whole_part(BigReal &br_, std::string str_) // only positive str (without check)
+std::istream& operator>>(std::istream& stream_, BigReal& bi_)
 {
-	if (str_.empty())
-		str_ = "0";
-	remove_leading_zeros(str_);
-	br_.b_whole_part.clear();
-	br_.b_whole_part.reserve(str_.length());
-	for (std::size_t i = 0U; i < str_.length(); ++i)
-		br_.b_whole_part.push_back(str_[i] - static_cast<std::int8_t>(48));
+	return bi_.operator>>(stream_);
 }
 
-void BigReal::to_big_real_fractional_part(BigReal &br_, std::string str_)
+std::ostream& operator<<(std::ostream& stream_, const BigReal& bi_)
 {
-	if (str_.empty())
-		str_ = "0"; // min value
-	remove_end_zeros(str_);
-	br_.b_fractional_part.clear();
-	br_.b_fractional_part.reserve(str_.length());
-	for (std::size_t i = 0U; i < str_.length(); ++i)
-		br_.b_fractional_part.push_back(str_[i] - static_cast<std::int8_t>(48));
+	return bi_.operator<<(stream_);
 }
 
-
-// ----------------------------------------------------------------------------
-// help
-void BigReal::append_leading_zeros(std::string& str_, std::size_t size_)
+std::to_chars_result to_chars(char* first_, char* last_, const BigReal& val_)
 {
-	if (str_.empty())
+	// same text as to_string(), straight into the buffer
+	char* it = first_;
+	if (!BigReal::write_text(val_, [&it, last_](const char* data_, std::size_t size_) {
+		if (static_cast<std::size_t>(last_ - it) < size_)
+			return false;
+		it = std::copy(data_, data_ + size_, it);
+		return true;
+	}))
+		return { last_, std::errc::value_too_large };
+	return { it, std::errc() };
+}
+
+std::from_chars_result from_chars(const char* first_, const char* last_, BigReal& val_)
+{
+	// [-]digits[.digits][e[+-]digits], at least one digit
+	auto skip_digits = [last_](const char* it_) {
+		return Digits::skip_digits(it_, last_);
+	};
+	const char* it = first_;
+	bool is_neg = (it != last_ && *it == '-');
+	if (is_neg)
+		++it;
+	const char* whole = it;
+	const char* whole_end = skip_digits(whole);
+	const char* frac = whole_end;
+	const char* frac_end = whole_end;
+	if (whole_end != last_ && *whole_end == '.')
 	{
-		str_.insert(0U, size_, '0');
-		return;
+		frac = whole_end + 1;
+		frac_end = skip_digits(frac);
 	}
-	std::size_t offset = (str_.front() == '-') ? 1U : 0U;
-	str_.insert(offset, size_, '0');
-}
-
-void BigReal::append_leading_zeros_by_size(std::string& str_, std::size_t size_)
-{
-	if (str_.empty())
+	if (whole == whole_end && frac == frac_end)
+		return { first_, std::errc::invalid_argument };
+	it = (frac == frac_end && whole_end != frac) ? frac : frac_end; // "5." takes the comma
+	std::int64_t exp = 0;
+	it = BigReal::read_exponent(it, last_, exp);
+	if (it == nullptr)
+		return { first_, std::errc::result_out_of_range };
+	while (frac_end != frac && *(frac_end - 1) == '0')
+		--frac_end;
+	// exp - the fractional digits, out of range unless every digit is zero
+	std::int64_t exp_coef = 0;
+	if (!BigReal::add_exponents(exp, -static_cast<std::int64_t>(frac_end - frac), exp_coef))
 	{
-		str_.insert(0U, size_, '0');
-		return;
+		auto is_zero = [](char ch_) { return ch_ == '0'; };
+		if (!std::all_of(whole, whole_end, is_zero) || frac != frac_end)
+			return { first_, std::errc::result_out_of_range };
 	}
-	std::size_t offset = (str_.front() == '-') ? 1U : 0U;
-	if (str_.length() - offset >= size_)
-		return;
-	str_.insert(offset, size_ - str_.length() + offset, '0');
-}
-
-void BigReal::append_leading_zeros_by_general_size(std::string& l_val_, std::string& r_val_)
-{
-	if (l_val_.empty() && r_val_.empty())
-		return;
-	std::size_t l_size = l_val_.size(); // only numbers
-	std::size_t r_size = r_val_.size();
-	if (l_val_.empty())
+	// coefficient from all the digits, the limbs of val_ are reused
+	if (frac == frac_end)
 	{
-		if (r_val_.front() == '-')
-			--r_size;
-		l_val_.insert(0U, r_size, '0');
-		return;
+		if (whole == whole_end)
+			val_.b_coef.reset(); // ".0"
+		else
+			from_chars(whole, whole_end, val_.b_coef);
 	}
-	if (r_val_.empty())
+	else
 	{
-		if (l_val_.front() == '-')
-			--l_size;
-		r_val_.insert(0U, l_size, '0');
-		return;
+		std::string digs(whole, whole_end);
+		digs.append(frac, frac_end);
+		from_chars(digs.data(), digs.data() + digs.length(), val_.b_coef);
 	}
-	if (r_val_.front() == '-')
-		--r_size;
-	if (l_val_.front() == '-')
-		--l_size;
-	std::size_t general_size = std::max(l_size, r_size);
-	append_leading_zeros_by_size(l_val_, general_size);
-	append_leading_zeros_by_size(r_val_, general_size);
+	val_.b_am_dig_after_com = BigReal::start_amount_digits_after_comma();
+	if (is_neg)
+		val_.b_coef.set_neg();
+	val_.b_exp = val_.is_zero() ? 0 : exp_coef;
+	return { it, std::errc() };
+}
+
+const char* BigReal::read_exponent(const char* first_, const char* last_, std::int64_t& exp_)
+{
+	// e[+-]digits, nothing is taken without digits
+	exp_ = 0;
+	if (first_ == last_ || (*first_ != 'e' && *first_ != 'E'))
+		return first_;
+	const char* it = first_ + 1;
+	bool is_neg = (it != last_ && *it == '-');
+	if (it != last_ && (*it == '-' || *it == '+'))
+		++it;
+	const char* digs_end = Digits::skip_digits(it, last_);
+	if (it == digs_end)
+		return first_;
+	std::uint64_t mag = 0U;
+	if (std::from_chars(it, digs_end, mag).ec != std::errc()
+		|| mag > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+		return nullptr;
+	exp_ = is_neg ? -static_cast<std::int64_t>(mag) : static_cast<std::int64_t>(mag);
+	return digs_end;
 }
 
-void BigReal::remove_leading_zeros(std::string& str_)
-{
-	if (str_.empty())
-		return;
-	std::size_t offset = (str_.front() == '-') ? 1U : 0U;
-	while (str_.length() > 1U + offset && str_[offset] == '0')
-		str_.erase(offset, 1U);
-}
 
-void BigReal::remove_leading_zeros_from_whole_part(BigReal& val_)
+// ----------------------------------------------------------------------------
+// to big real from str
+BigReal BigReal::to_big_real(const std::string& str_)
 {
-	while (val_.b_whole_part.size() > 1U && val_.b_whole_part.front() == static_cast<std::int8_t>(0))
-		val_.b_whole_part.erase(val_.b_whole_part.begin());
+	BigReal br;
+	to_big_real(br, str_);
+	return br;
 }
 
-void BigReal::append_end_zeros(std::string& str_, std::size_t size_)
+void BigReal::to_big_real(BigReal &br_, const std::string& str_) // without check
 {
-	str_.insert(str_.length(), size_, '0');
+	if (from_chars(str_.data(), str_.data() + str_.length(), br_).ec != std::errc())
+		br_ = BigReal();
 }
 
-void BigReal::append_end_zeros_by_size(std::string& str_, std::size_t size_) // without check
+
+// ----------------------------------------------------------------------------
+// help
+BigInt BigReal::scaled(const BigInt& val_, std::size_t am_)
 {
-	// consider only numbers
-	if (str_.empty())
+	// val_ * 10^am_, one limb product up to 10^19
+	if (am_ == 0U)
+		return val_;
+	if (am_ <= 19U)
 	{
-		str_.insert(0U, size_, '0');
-		return;
+		std::uint64_t mul = 1U;
+		for (std::size_t i = 0U; i < am_; ++i)
+			mul *= 10U;
+		return val_ * mul;
 	}
-	std::size_t offset = (str_.front() == '-') ? 1U : 0U;
-	if (str_.length() - offset >= size_)
-		return;
-	str_.insert(str_.length(), size_ - str_.length() + offset, '0');
+	return (val_ * power(5U, am_)) << am_; // 5^am_ is shorter than 10^am_
 }
 
-void BigReal::append_end_zeros_by_general_size(std::string& l_val_, std::string& r_val_)
+std::int64_t BigReal::digits_low(const BigInt& coef_)
 {
-	if (l_val_.empty() && r_val_.empty())
-		return;
-	std::size_t l_size = l_val_.size(); // only numbers
-	std::size_t r_size = r_val_.size();
-	if (l_val_.empty())
-	{
-		if (r_val_.front() == '-')
-			--r_size;
-		l_val_.insert(0U, r_size, '0');
-		return;
-	}
-	if (r_val_.empty())
-	{
-		if (l_val_.front() == '-')
-			--l_size;
-		r_val_.insert(0U, l_size, '0');
-		return;
-	}
-	if (r_val_.front() == '-')
-		--r_size;
-	if (l_val_.front() == '-')
-		--l_size;
-	std::size_t general_size = std::max(l_size, r_size);
-	append_end_zeros_by_size(l_val_, general_size);
-	append_end_zeros_by_size(r_val_, general_size);
+	// 2^(bits - 1) <= |coef_| < 2^bits, log10(2) = 0.30103
+	return static_cast<std::int64_t>((coef_.bit_length() - 1U) * 30102U / 100000U);
 }
 
-void BigReal::append_end_zeros_by_general_size(BigInt& l_val_, BigInt& r_val_)
+std::int64_t BigReal::digits_high(const BigInt& coef_)
 {
-	std::string l_val = l_val_.to_string();
-	std::string r_val = r_val_.to_string();
-	append_end_zeros_by_general_size(l_val, r_val);
-	l_val_ = BigInt::to_big_int(l_val);
-	r_val_ = BigInt::to_big_int(r_val);
+	return static_cast<std::int64_t>(coef_.bit_length() * 30103U / 100000U) + 1;
 }
 
-void BigReal::remove_end_zeros(std::string& str_)
+std::size_t BigReal::decimal_length(const BigInt& coef_)
 {
-	if (str_.empty())
-		return;
-	std::size_t offset = (str_.front() == '-') ? 1U : 0U;
-	while (str_.length() > 1U + offset && str_.back() == '0')
-		str_.pop_back();
+	// am <= digits of |coef_| <= am + 3: (bits - 1) * log10(2) is off by far less than a digit in double
+	double low = static_cast<double>(coef_.bit_length() - 1U) * 0.30102999566398120;
+	std::size_t am = (low >= 2.0) ? static_cast<std::size_t>(low) : 1U;
+	BigInt unit = scaled(BigInt::to_big_int(coef_.is_neg() ? -1 : 1), am);
+	while (coef_.is_neg() ? coef_ <= unit : coef_ >= unit) // three times at most
+	{
+		++am;
+		unit *= 10;
+	}
+	return am;
 }
 
-void BigReal::remove_end_zeros_from_fractional_part(BigReal& val_)
+std::int64_t BigReal::exponent_gap(std::int64_t l_exp_, std::int64_t r_exp_)
 {
-	while (val_.b_fractional_part.size() > 1U && val_.b_fractional_part.back() == static_cast<std::int8_t>(0))
-		val_.b_fractional_part.pop_back();
+	// saturated to +-max: still beyond every digit count when it is compared with them
+	if (r_exp_ < 0 && l_exp_ > std::numeric_limits<std::int64_t>::max() + r_exp_)
+		return std::numeric_limits<std::int64_t>::max();
+	if (r_exp_ >= 0 && l_exp_ < -std::numeric_limits<std::int64_t>::max() + r_exp_)
+		return -std::numeric_limits<std::int64_t>::max();
+	return l_exp_ - r_exp_;
+}
+
+bool BigReal::add_exponents(std::int64_t l_exp_, std::int64_t r_exp_, std::int64_t& exp_)
+{
+	if ((r_exp_ > 0 && l_exp_ > std::numeric_limits<std::int64_t>::max() - r_exp_)
+		|| (r_exp_ < 0 && l_exp_ < std::numeric_limits<std::int64_t>::min() - r_exp_))
+		return false;
+	exp_ = l_exp_ + r_exp_;
+	return true;
 }
 
 
@@ -2262,60 +2823,139 @@ void BigReal::remove_end_zeros_from_fractional_part(BigReal& val_)
 // to big real
 BigReal BigReal::to_big_real(std::int32_t val_)
 {
-	BigReal br;
-	to_big_real(br, std::to_string(val_));
-	return br;
+	return to_big_real(BigInt::to_big_int(val_), 0);
 }
 
+#ifdef LEZ_SIZE_T_OVERLOADS
 BigReal BigReal::to_big_real(std::size_t val_)
 {
-	BigReal br;
-	to_big_real(br, std::to_string(val_));
-	return br;
+	return to_big_real(BigInt::to_big_int(val_), 0);
 }
+#endif
 
 BigReal BigReal::to_big_real(std::int64_t val_)
 {
-	BigReal br;
-	to_big_real(br, std::to_string(val_));
-	return br;
+	return to_big_real(BigInt::to_big_int(val_), 0);
 }
 
 BigReal BigReal::to_big_real(std::uint64_t val_) // only whole
 {
-	BigReal br;
-	to_big_real(br, std::to_string(val_));
-	return br;
+	return to_big_real(BigInt::to_big_int(val_), 0);
 }
 
 BigReal BigReal::to_big_real(const BigInt& val_)
+{
+	return to_big_real(BigInt(val_), 0);
+}
+
+BigReal BigReal::to_big_real(BigInt coef_, std::int64_t exp_)
 {
 	BigReal br;
-	to_big_real(br, val_.to_string());
+	br.b_exp = coef_.is_zero() ? 0 : exp_;
+	br.b_coef = std::move(coef_);
 	return br;
 }
 
 BigReal BigReal::to_big_real(float val_)
 {
-	BigReal br;
-	to_big_real(br, std::to_string(val_));
-	return br;
+	return to_big_real(static_cast<double>(val_)); // exact
 }
 
 BigReal BigReal::to_big_real(double val_)
 {
+	// exact: mantissa * 2^exp, 2^-k = 5^k * 10^-k
 	BigReal br;
-	to_big_real(br, std::to_string(val_));
+	if (!std::isfinite(val_) || val_ == 0.0)
+		return br; // nan and infinities are zero
+	int exp = 0;
+	double frac = std::frexp(std::fabs(val_), &exp); // [0.5, 1)
+	auto mant = static_cast<std::uint64_t>(std::ldexp(frac, std::numeric_limits<double>::digits));
+	exp -= std::numeric_limits<double>::digits;
+	while (exp < 0 && (mant & 1U) == 0U)
+	{
+		mant >>= 1U;
+		++exp;
+	}
+	BigInt coef = BigInt::to_big_int(mant);
+	if (exp >= 0)
+		br.b_coef = coef << static_cast<std::size_t>(exp);
+	else
+	{
+		br.b_coef = coef * power(5U, static_cast<std::size_t>(-exp));
+		br.b_exp = exp;
+	}
+	if (val_ < 0.0)
+		br.b_coef.set_neg();
 	return br;
 }
 
+BigInt BigReal::power(std::uint32_t base_, std::size_t exp_)
+{
+	// leading bits of exp_ first: squarings and one limb products only
+	BigInt res = BigInt::to_big_int(static_cast<std::uint64_t>(1U));
+	std::size_t am_steps = 0U;
+	for (std::size_t i = exp_; i != 0U; i >>= 1U)
+		++am_steps;
+	for (std::size_t i = am_steps; i != 0U; --i)
+	{
+		res *= res;
+		if (((exp_ >> (i - 1U)) & 1U) != 0U)
+			res *= static_cast<std::uint64_t>(base_);
+	}
+	return res;
+}
+
+BigInt BigReal::power(const BigInt& base_, std::size_t exp_)
+{
+	BigInt res = BigInt::to_big_int(static_cast<std::uint64_t>(1U));
+	BigInt sq = base_;
+	for (; exp_ != 0U; exp_ >>= 1U)
+	{
+		if ((exp_ & 1U) != 0U)
+			res *= sq;
+		if (exp_ > 1U)
+			sq *= sq;
+	}
+	return res;
+}
+
+BigInt BigReal::power_high(const BigInt& base_, std::size_t exp_, std::size_t am_bits_, std::int64_t& bin_exp_)
+{
+	// leading bits of exp_ first, truncated after every step: each squaring doubles the relative error,
+	// so bit_length(exp_) + 3 more bits keep it below 2^-am_bits_
+	std::size_t am_steps = 0U;
+	for (std::size_t i = exp_; i != 0U; i >>= 1U)
+		++am_steps;
+	std::size_t am_keep = am_bits_ + am_steps + 3U;
+	BigInt res = BigInt::to_big_int(static_cast<std::uint64_t>(1U));
+	bin_exp_ = 0;
+	for (std::size_t i = am_steps; i != 0U; --i)
+	{
+		res *= res;
+		bin_exp_ *= 2;
+		if (((exp_ >> (i - 1U)) & 1U) != 0U)
+			res *= base_;
+		cut_bits(res, bin_exp_, am_keep);
+	}
+	return res;
+}
+
+void BigReal::cut_bits(BigInt& mag_, std::int64_t& exp_, std::size_t am_bits_)
+{
+	if (mag_.bit_length() > am_bits_)
+	{
+		std::size_t am_drop = mag_.bit_length() - am_bits_;
+		mag_ >>= am_drop;
+		exp_ += static_cast<std::int64_t>(am_drop);
+	}
+}
+
 void BigReal::swap(BigReal& l_val_, BigReal& r_val_)
 {
 	using std::swap;
-	swap(l_val_.b_whole_part, r_val_.b_whole_part);
-	swap(l_val_.b_fractional_part, r_val_.b_fractional_part);
+	BigInt::swap(l_val_.b_coef, r_val_.b_coef);
+	swap(l_val_.b_exp, r_val_.b_exp);
 	swap(l_val_.b_am_dig_after_com, r_val_.b_am_dig_after_com);
-	swap(l_val_.b_is_neg, r_val_.b_is_neg);
 }
 
 std::size_t& BigReal::start_amount_digits_after_comma()
@@ -2324,6 +2964,24 @@ std::size_t& BigReal::start_amount_digits_after_comma()
 	return start_am_dig_after_com;
 }
 
+DecimalRounding& BigReal::start_rounding()
+{
+	static DecimalRounding start_mode = DecimalRounding::truncate;
+	return start_mode;
+}
+
+std::size_t& BigReal::guard_digits()
+{
+	static std::size_t am_guard = std::string::npos;
+	return am_guard;
+}
+
+std::size_t& BigReal::exponent_zeros_limit()
+{
+	static std::size_t limit = std::size_t(1) << 20U;
+	return limit;
+}
+
 BigReal::~BigReal()
 {
 }
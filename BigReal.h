@@ -8,14 +8,25 @@
 
 #include <vector>
 #include <string>
+#include <charconv>
+#include <optional>
+
+#include "BigInt.h"
 
 
 namespace lez
 {
-	class BigInt; // forward declaration
+	enum class DecimalRounding { half_even, half_up, floor, ceil, truncate }; // half_up: ties away from zero
 
 	// start_amount_digits_after_comma() edit for all class
-	// division by zero is zero!
+	// division by zero is zero! so is a product or a quotient whose exponent would be beyond int64
+	// val = coefficient * 10^exponent: + - * and comparisons work on the BigInt coefficient at a common
+	// scale, / stops after get_amount_digits_after_comma() digits; no text on the way
+	// start_rounding() edit for all class: / and the text (to_string, <<, to_chars, StreamWriter) round with it
+	// (truncate by default); guard_digits() edit for all class: + - * / keep get_amount_digits_after_comma()
+	// + guard_digits() fractional digits, rounded as well (npos by default: + - * are exact, except that a
+	// summand more than exponent_zeros_limit() digits below the other one is kept as a sticky digit)
+	// then * works out only the high part of the product that the kept digits need
 
 	class BigReal
 	{
@@ -24,7 +35,9 @@ namespace lez
 		BigReal(const BigReal& val_);
 		BigReal(BigReal&& val_);
 		explicit BigReal(std::int32_t val_); // or implicit
+#ifdef LEZ_SIZE_T_OVERLOADS
 		explicit BigReal(std::size_t val_);
+#endif
 		explicit BigReal(std::int64_t val_);
 		explicit BigReal(std::uint64_t val_);
 		explicit BigReal(const BigInt& val_);
@@ -32,7 +45,9 @@ namespace lez
 		explicit BigReal(double val_);
 
 		BigReal& operator=(std::int32_t val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigReal& operator=(std::size_t val_);
+#endif
 		BigReal& operator=(std::int64_t val_);
 		BigReal& operator=(std::uint64_t val_);
 		BigReal& operator=(const BigInt& val_);
@@ -40,14 +55,30 @@ namespace lez
 		BigReal& operator=(double val_);
 		BigReal& operator=(BigReal val_);
 
+		// whole part; saturating; _checked: empty if out of range; _wrapping: low bits of two's complement
+		// (decided from the exponent, huge values are never expanded)
 		std::int32_t to_int32() const;
 		std::size_t to_size() const;
 		std::int64_t to_int64() const;
 		std::uint64_t to_uint64() const;
+		std::optional<std::int32_t> to_int32_checked() const;
+		std::optional<std::size_t> to_size_checked() const;
+		std::optional<std::int64_t> to_int64_checked() const;
+		std::optional<std::uint64_t> to_uint64_checked() const;
+		std::int32_t to_int32_wrapping() const;
+		std::size_t to_size_wrapping() const;
+		std::int64_t to_int64_wrapping() const;
+		std::uint64_t to_uint64_wrapping() const;
+		bool fits_int32() const;
+		bool fits_size() const;
+		bool fits_int64() const;
+		bool fits_uint64() const;
 		BigInt to_big_int() const;
-		float to_float() const;
+		float to_float() const; // correctly rounded from the digits, no text
 		double to_double() const;
 
+		const BigInt& coefficient() const; // signed, trailing zeros are not stripped
+		std::int64_t exponent() const; // decimal
 		std::size_t amount_places() const; // only numbers
 		std::size_t amount_places_whole_part() const;
 		std::size_t amount_places_fractional_part() const;
@@ -60,7 +91,9 @@ namespace lez
 
 		explicit operator bool() const;
 		explicit operator std::int32_t() const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		explicit operator std::size_t() const;
+#endif
 		explicit operator std::int64_t() const;
 		explicit operator std::uint64_t() const;
 		explicit operator BigInt() const;
@@ -77,7 +110,9 @@ namespace lez
 		const BigReal operator++(int);
 
 		const BigReal operator+(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		const BigReal operator+(std::size_t r_val_) const;
+#endif
 		const BigReal operator+(std::int64_t r_val_) const;
 		const BigReal operator+(std::uint64_t r_val_) const;
 		const BigReal operator+(const BigInt& r_val_) const;
@@ -86,7 +121,9 @@ namespace lez
 		const BigReal operator+(const BigReal& r_val_) const;
 
 		const BigReal operator-(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		const BigReal operator-(std::size_t r_val_) const;
+#endif
 		const BigReal operator-(std::int64_t r_val_) const;
 		const BigReal operator-(std::uint64_t r_val_) const;
 		const BigReal operator-(const BigInt& r_val_) const;
@@ -95,7 +132,9 @@ namespace lez
 		const BigReal operator-(const BigReal& r_val_) const;
 
 		BigReal& operator+=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigReal& operator+=(std::size_t r_val_);
+#endif
 		BigReal& operator+=(std::int64_t r_val_);
 		BigReal& operator+=(std::uint64_t r_val_);
 		BigReal& operator+=(const BigInt& r_val_);
@@ -104,7 +143,9 @@ namespace lez
 		BigReal& operator+=(const BigReal& r_val_);
 
 		BigReal& operator-=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigReal& operator-=(std::size_t r_val_);
+#endif
 		BigReal& operator-=(std::int64_t r_val_);
 		BigReal& operator-=(std::uint64_t r_val_);
 		BigReal& operator-=(const BigInt& r_val_);
@@ -113,7 +154,9 @@ namespace lez
 		BigReal& operator-=(const BigReal& r_val_);
 
 		friend const BigReal operator+(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend const BigReal operator+(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend const BigReal operator+(std::int64_t l_val_, const BigReal& r_val_);
 		friend const BigReal operator+(std::uint64_t l_val_, const BigReal& r_val_);
 		friend const BigReal operator+(const BigInt& l_val_, const BigReal& r_val_);
@@ -121,7 +164,9 @@ namespace lez
 		friend const BigReal operator+(double l_val_, const BigReal& r_val_);
 
 		friend const BigReal operator-(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend const BigReal operator-(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend const BigReal operator-(std::int64_t l_val_, const BigReal& r_val_);
 		friend const BigReal operator-(std::uint64_t l_val_, const BigReal& r_val_);
 		friend const BigReal operator-(const BigInt& l_val_, const BigReal& r_val_);
@@ -129,7 +174,9 @@ namespace lez
 		friend const BigReal operator-(double l_val_, const BigReal& r_val_);
 
 		const BigReal operator*(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		const BigReal operator*(std::size_t r_val_) const;
+#endif
 		const BigReal operator*(std::int64_t r_val_) const;
 		const BigReal operator*(std::uint64_t r_val_) const;
 		const BigReal operator*(const BigInt& r_val_) const;
@@ -138,7 +185,9 @@ namespace lez
 		const BigReal operator*(const BigReal& r_val_) const;
 
 		const BigReal operator/(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		const BigReal operator/(std::size_t r_val_) const;
+#endif
 		const BigReal operator/(std::int64_t r_val_) const;
 		const BigReal operator/(std::uint64_t r_val_) const;
 		const BigReal operator/(const BigInt& r_val_) const;
@@ -147,7 +196,9 @@ namespace lez
 		const BigReal operator/(const BigReal& r_val_) const;
 
 		const BigReal operator%(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		const BigReal operator%(std::size_t r_val_) const;
+#endif
 		const BigReal operator%(std::int64_t r_val_) const;
 		const BigReal operator%(std::uint64_t r_val_) const;
 		const BigReal operator%(const BigInt& r_val_) const;
@@ -156,7 +207,9 @@ namespace lez
 		const BigReal operator%(const BigReal& r_val_) const;
 
 		BigReal& operator*=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigReal& operator*=(std::size_t r_val_);
+#endif
 		BigReal& operator*=(std::int64_t r_val_);
 		BigReal& operator*=(std::uint64_t r_val_);
 		BigReal& operator*=(const BigInt& r_val_);
@@ -165,7 +218,9 @@ namespace lez
 		BigReal& operator*=(const BigReal& r_val_);
 
 		BigReal& operator/=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigReal& operator/=(std::size_t r_val_);
+#endif
 		BigReal& operator/=(std::int64_t r_val_);
 		BigReal& operator/=(std::uint64_t r_val_);
 		BigReal& operator/=(const BigInt& r_val_);
@@ -174,7 +229,9 @@ namespace lez
 		BigReal& operator/=(const BigReal& r_val_);
 
 		BigReal& operator%=(std::int32_t r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		BigReal& operator%=(std::size_t r_val_);
+#endif
 		BigReal& operator%=(std::int64_t r_val_);
 		BigReal& operator%=(std::uint64_t r_val_);
 		BigReal& operator%=(const BigInt& r_val_);
@@ -183,7 +240,9 @@ namespace lez
 		BigReal& operator%=(const BigReal& r_val_);
 
 		friend const BigReal operator*(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend const BigReal operator*(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend const BigReal operator*(std::int64_t l_val_, const BigReal& r_val_);
 		friend const BigReal operator*(std::uint64_t l_val_, const BigReal& r_val_);
 		friend const BigReal operator*(const BigInt& l_val_, const BigReal& r_val_);
@@ -191,7 +250,9 @@ namespace lez
 		friend const BigReal operator*(double l_val_, const BigReal& r_val_);
 
 		friend const BigReal operator/(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend const BigReal operator/(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend const BigReal operator/(std::int64_t l_val_, const BigReal& r_val_);
 		friend const BigReal operator/(std::uint64_t l_val_, const BigReal& r_val_);
 		friend const BigReal operator/(const BigInt& l_val_, const BigReal& r_val_);
@@ -199,7 +260,9 @@ namespace lez
 		friend const BigReal operator/(double l_val_, const BigReal& r_val_);
 
 		friend const BigReal operator%(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend const BigReal operator%(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend const BigReal operator%(std::int64_t l_val_, const BigReal& r_val_);
 		friend const BigReal operator%(std::uint64_t l_val_, const BigReal& r_val_);
 		friend const BigReal operator%(const BigInt& l_val_, const BigReal& r_val_);
@@ -207,7 +270,9 @@ namespace lez
 		friend const BigReal operator%(double l_val_, const BigReal& r_val_);
 
 		bool operator>(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator>(std::size_t r_val_) const;
+#endif
 		bool operator>(std::int64_t r_val_) const;
 		bool operator>(std::uint64_t r_val_) const;
 		bool operator>(const BigInt& r_val_) const;
@@ -216,7 +281,9 @@ namespace lez
 		bool operator>(const BigReal& r_val_) const;
 
 		bool operator<(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator<(std::size_t r_val_) const;
+#endif
 		bool operator<(std::int64_t r_val_) const;
 		bool operator<(std::uint64_t r_val_) const;
 		bool operator<(const BigInt& r_val_) const;
@@ -225,7 +292,9 @@ namespace lez
 		bool operator<(const BigReal& r_val_) const;
 
 		bool operator>=(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator>=(std::size_t r_val_) const;
+#endif
 		bool operator>=(std::int64_t r_val_) const;
 		bool operator>=(std::uint64_t r_val_) const;
 		bool operator>=(const BigInt& r_val_) const;
@@ -234,7 +303,9 @@ namespace lez
 		bool operator>=(const BigReal& r_val_) const;
 
 		bool operator<=(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator<=(std::size_t r_val_) const;
+#endif
 		bool operator<=(std::int64_t r_val_) const;
 		bool operator<=(std::uint64_t r_val_) const;
 		bool operator<=(const BigInt& r_val_) const;
@@ -243,7 +314,9 @@ namespace lez
 		bool operator<=(const BigReal& r_val_) const;
 
 		bool operator==(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator==(std::size_t r_val_) const;
+#endif
 		bool operator==(std::int64_t r_val_) const;
 		bool operator==(std::uint64_t r_val_) const;
 		bool operator==(const BigInt& r_val_) const;
@@ -252,7 +325,9 @@ namespace lez
 		bool operator==(const BigReal& r_val_) const;
 
 		bool operator!=(std::int32_t r_val_) const;
+#ifdef LEZ_SIZE_T_OVERLOADS
 		bool operator!=(std::size_t r_val_) const;
+#endif
 		bool operator!=(std::int64_t r_val_) const;
 		bool operator!=(std::uint64_t r_val_) const;
 		bool operator!=(const BigInt& r_val_) const;
@@ -261,7 +336,9 @@ namespace lez
 		bool operator!=(const BigReal& r_val_) const;
 
 		friend bool operator>(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator>(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend bool operator>(std::int64_t l_val_, const BigReal& r_val_);
 		friend bool operator>(std::uint64_t l_val_, const BigReal& r_val_);
 		friend bool operator>(const BigInt& l_val_, const BigReal& r_val_);
@@ -269,7 +346,9 @@ namespace lez
 		friend bool operator>(double l_val_, const BigReal& r_val_);
 
 		friend bool operator<(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator<(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend bool operator<(std::int64_t l_val_, const BigReal& r_val_);
 		friend bool operator<(std::uint64_t l_val_, const BigReal& r_val_);
 		friend bool operator<(const BigInt& l_val_, const BigReal& r_val_);
@@ -277,7 +356,9 @@ namespace lez
 		friend bool operator<(double l_val_, const BigReal& r_val_);
 
 		friend bool operator>=(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator>=(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend bool operator>=(std::int64_t l_val_, const BigReal& r_val_);
 		friend bool operator>=(std::uint64_t l_val_, const BigReal& r_val_);
 		friend bool operator>=(const BigInt& l_val_, const BigReal& r_val_);
@@ -285,7 +366,9 @@ namespace lez
 		friend bool operator>=(double l_val_, const BigReal& r_val_);
 
 		friend bool operator<=(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator<=(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend bool operator<=(std::int64_t l_val_, const BigReal& r_val_);
 		friend bool operator<=(std::uint64_t l_val_, const BigReal& r_val_);
 		friend bool operator<=(const BigInt& l_val_, const BigReal& r_val_);
@@ -293,7 +376,9 @@ namespace lez
 		friend bool operator<=(double l_val_, const BigReal& r_val_);
 
 		friend bool operator==(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator==(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend bool operator==(std::int64_t l_val_, const BigReal& r_val_);
 		friend bool operator==(std::uint64_t l_val_, const BigReal& r_val_);
 		friend bool operator==(const BigInt& l_val_, const BigReal& r_val_);
@@ -301,7 +386,9 @@ namespace lez
 		friend bool operator==(double l_val_, const BigReal& r_val_);
 
 		friend bool operator!=(std::int32_t l_val_, const BigReal& r_val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		friend bool operator!=(std::size_t l_val_, const BigReal& r_val_);
+#endif
 		friend bool operator!=(std::int64_t l_val_, const BigReal& r_val_);
 		friend bool operator!=(std::uint64_t l_val_, const BigReal& r_val_);
 		friend bool operator!=(const BigInt& l_val_, const BigReal& r_val_);
@@ -310,81 +397,125 @@ namespace lez
 
 		std::size_t get_amount_digits_after_comma() const;
 		void set_amount_digits_after_comma(std::size_t am_dig_after_com_);
+		BigReal rounded(std::size_t am_frac_, DecimalRounding mode_) const; // am_frac_ fractional digits at most
 
 		std::istream& operator>>(std::istream& stream_);
 		std::ostream& operator<<(std::ostream& stream_) const;
+		// positional; more than exponent_zeros_limit() zeros of the exponent: to_string_scientific() with every digit
 		std::string to_string() const;
 		std::string to_string_unsigned() const;
 		std::string to_string_whole_part() const;
 		std::string to_string_unsigned_whole_part() const;
 		std::string to_string_fractional_part() const;
+		std::string to_string_scientific(std::size_t digits_) const; // d.ddde-5, digits_ significant (truncated)
+		std::string to_string_engineering(std::size_t digits_) const; // ddd.de-6, exponent a multiple of 3
 
 		friend std::istream& operator>>(std::istream& stream_, BigReal& bi_);
 		friend std::ostream& operator<<(std::ostream& stream_, const BigReal& bi_);
+		friend std::to_chars_result to_chars(char* first_, char* last_, const BigReal& val_);
+		friend std::from_chars_result from_chars(const char* first_, const char* last_, BigReal& val_);
 
 		static BigReal to_big_real(std::int32_t val_);
+#ifdef LEZ_SIZE_T_OVERLOADS
 		static BigReal to_big_real(std::size_t val_);
+#endif
 		static BigReal to_big_real(std::int64_t val_);
 		static BigReal to_big_real(std::uint64_t val_);
 		static BigReal to_big_real(const BigInt& val_);
-		static BigReal to_big_real(float val_);
+		static BigReal to_big_real(BigInt coef_, std::int64_t exp_); // coef_ * 10^exp_
+		static BigReal to_big_real(float val_); // exact binary value, every digit; nan and inf are zero
 		static BigReal to_big_real(double val_);
 		static BigReal to_big_real(const std::string& str_);
 		static void to_big_real(BigReal &br_, const std::string& str_); // full
 
+		// l_val_ / r_val_ correctly rounded to am_frac_ fractional digits; long operands and long quotients
+		// go through the Newton reciprocal of the divisor cut to the precision of the quotient
+		static BigReal divide(const BigReal& l_val_, const BigReal& r_val_, std::size_t am_frac_, DecimalRounding mode_);
+		// roots correctly rounded to am_frac_ fractional digits: the inverse root by Newton steps that double
+		// the precision, then one multiplication; even roots of negatives are zero, as is rsqrt(0) and root 0
+		static BigReal sqrt(const BigReal& val_, std::size_t am_frac_, DecimalRounding mode_);
+		static BigReal rsqrt(const BigReal& val_, std::size_t am_frac_, DecimalRounding mode_); // 1 / sqrt
+		// (rsqrt divides nothing: the inverse root of the coefficient, exact squares only near a rounding point)
+		static BigReal cbrt(const BigReal& val_, std::size_t am_frac_, DecimalRounding mode_);
+		static BigReal root(const BigReal& val_, std::uint32_t n_, std::size_t am_frac_, DecimalRounding mode_);
+
 		static void swap(BigReal& l_val_, BigReal& r_val_);
 		static std::size_t& start_amount_digits_after_comma(); // lval, for all class, singleton?
+		static DecimalRounding& start_rounding(); // lval, for all class, default = truncate
+		static std::size_t& guard_digits(); // lval, for all class, default = npos (+ - * keep every digit)
+		// lval, for all class, default = 2^20: zeros that an exponent is expanded to at most, in the text and in + -
+		static std::size_t& exponent_zeros_limit();
 
 		~BigReal();
 
 	private:
-
-		static void append_leading_zeros(std::string& str_, std::size_t size_);
-		static void append_leading_zeros_by_size(std::string& str_, std::size_t size_);
-		static void append_leading_zeros_by_general_size(std::string& l_val_, std::string& r_val_);
-		static void remove_leading_zeros(std::string& str_);
-		static void remove_leading_zeros_from_whole_part(BigReal& val_);
-
-		static void append_end_zeros(std::string& str_, std::size_t size_);
-		static void append_end_zeros_by_size(std::string& str_, std::size_t size_);
-		static void append_end_zeros_by_general_size(std::string& l_val_, std::string& r_val_);
-		static void append_end_zeros_by_general_size(BigInt& l_val_, BigInt& r_val_);
-		static void remove_end_zeros(std::string& str_);
-		static void remove_end_zeros_from_fractional_part(BigReal& val_);
-
-		static void to_big_real_whole_part(BigReal &br_, std::string str_); // edit whole part
-		static void to_big_real_fractional_part(BigReal &br_, std::string str_); // edit fractional part
-		static BigReal to_big_real_from_big_int(const BigInt& wp_val_, const BigInt& fp_val_); // only positive
-
-		static bool is_carry_after_addition_fractional_part(const BigInt& l_val_,
-			const BigInt& r_val_,
-			const BigInt& res_);
-		static BigInt remove_first_number_from_big_int(const BigInt& val_); // after carry
-		static void set_comma_in_result_string_after_multiplication(std::string& res_str_, std::size_t offset_for_com_);
-
-		static BigReal addition_positive_or_negative_numbers(const BigReal& l_val_, const BigReal& r_val_);
-		static BigReal subtraction(const BigReal& l_val_, const BigReal& r_val_); // unsigned, l - r
-		static BigReal subtraction_in_order(const BigReal& l_val_, const BigReal& r_val_); // more - less
-
-		// unsigned
-		static bool logical_more(const BigReal& l_val_, const BigReal& r_val_);
-		static bool logical_more_whole_part(const BigReal& l_val_, const BigReal& r_val_);
-		static bool logical_more_fractional_part(const BigReal& l_val_, const BigReal& r_val_);
-
-		static bool logical_less(BigReal l_val_, BigReal r_val_);
-		static bool logical_less_whole_part(BigReal l_val_, BigReal r_val_);
-		static bool logical_less_fractional_part(BigReal l_val_, BigReal r_val_);
-
-		static bool logical_equal(const BigReal& l_val_, const BigReal& r_val_);
-		static bool logical_equal_whole_part(const BigReal& l_val_, const BigReal& r_val_);
-		static bool logical_equal_fractional_part(const BigReal& l_val_, const BigReal& r_val_);
+		friend class StreamWriter;
+		friend class BigFloat;
+
+		std::string significant_digits(std::size_t am_, std::int64_t& exp10_) const; // d.dd * 10^exp10_, zero padded
+		// |val| positionally: whole digits and the first am_frac_ fractional ones, trailing zeros dropped ("0" if none);
+		// beyond exponent_zeros_limit() whole_ is the scientific text and frac_ is empty
+		void split_digits(std::string& whole_, std::string& frac_, std::size_t am_frac_) const;
+		// the to_string() text a piece at a time, rounded by start_rounding() first; false once out_ is
+		static bool write_text(const BigReal& val_, const std::function<bool(const char*, std::size_t)>& out_);
+		static bool write_zeros(std::size_t am_, const std::function<bool(const char*, std::size_t)>& out_);
+		void bound(); // bounded_digits() fractional digits at most
+		std::size_t bounded_digits() const; // get_amount_digits_after_comma() + guard_digits(), saturated
+		// mag_ * 10^exp_ (and something below its last digit if is_sticky_) to a multiple of 10^exp_to_, signed
+		static void round_coef(BigInt& mag_, std::int64_t& exp_, std::int64_t exp_to_, bool is_neg_, bool is_sticky_,
+			DecimalRounding mode_);
+		// quot_ (magnitude) one more if mode_ rounds away from zero; half_: dropped part against half a unit
+		static void round_quotient(BigInt& quot_, int half_, bool is_rest_, bool is_neg_, DecimalRounding mode_);
+		// |l_coef_ * r_coef_| / 10^am_drop_ rounded, from the high bits of the operands (mulhigh);
+		// false if it saves nothing or the dropped bits could change the rounding
+		static bool short_product(const BigInt& l_coef_, const BigInt& r_coef_, std::size_t am_drop_, bool is_neg_,
+			DecimalRounding mode_, BigInt& res_);
+		// |l_coef_| * 10^shift_ / |r_coef_| rounded, from the high bits and the Newton reciprocal of the divisor;
+		// false if the exact division is as cheap or the dropped bits could change the rounding
+		static bool short_quotient(const BigInt& l_coef_, const BigInt& r_coef_, std::int64_t shift_, bool is_neg_,
+			DecimalRounding mode_, BigInt& res_);
+		// a positive quotient known by lo_ < quot * 2^16 < hi_, rounded and signed; false if they do not settle it
+		static bool round_bounds(const BigInt& lo_, const BigInt& hi_, bool is_neg_, DecimalRounding mode_, BigInt& res_);
+		// (num_ / den_)^(1/n_) rounded to a whole number and signed, num_ / den_ = |val| * 10^(n_ * am_frac_) > 0
+		static BigReal root_rounded(BigInt num_, const BigInt& den_, std::uint32_t n_, std::size_t am_frac_, bool is_neg_,
+			DecimalRounding mode_);
+		// the root rounded to am_frac_ digits and signed from twice_ = floor(2 * root), is_exact_ if that is 2 * root
+		static BigReal root_from_twice(BigInt twice_, bool is_exact_, std::size_t am_frac_, bool is_neg_,
+			DecimalRounding mode_);
+		static BigInt integer_root(const BigInt& val_, std::uint32_t n_, bool& is_exact_); // floor(val_^(1/n_))
+		// about 2^am_bits_ * a^(-1/n_) for a = val_ / 2^am_scale_, 2^-n_ <= a < 1
+		static BigInt inverse_root(const BigInt& val_, std::size_t am_scale_, std::uint32_t n_, std::size_t am_bits_);
+		// correctly rounded (half to even) binary value with digits_ bits, numeric_limits exponents
+		double to_binary(int digits_, int min_exp_, int max_exp_) const;
+		static BigInt power(std::uint32_t base_, std::size_t exp_); // base_^exp_
+		static BigInt power(const BigInt& base_, std::size_t exp_);
+		static BigInt scaled(const BigInt& val_, std::size_t am_); // val_ * 10^am_
+		// the high bits of base_^exp_: res * 2^bin_exp_ <= base_^exp_ < res * 2^bin_exp_ * (1 + 2^-am_bits_)
+		static BigInt power_high(const BigInt& base_, std::size_t exp_, std::size_t am_bits_, std::int64_t& bin_exp_);
+		// val = mag_ * 2^exp_ cut to am_bits_ bits: less than 2^-(am_bits_ - 1) too little
+		static void cut_bits(BigInt& mag_, std::int64_t& exp_, std::size_t am_bits_);
+		static int compare(const BigReal& l_val_, const BigReal& r_val_); // -1, 0, 1
+		BigInt clamped_big_int() const; // to_big_int(), or +-2^64 if the whole part is 10^20 at least
+		static std::int64_t digits_low(const BigInt& coef_); // 10^digits_low <= |coef_|, coef_ != 0
+		static std::int64_t digits_high(const BigInt& coef_); // |coef_| < 10^digits_high
+		static std::size_t decimal_length(const BigInt& coef_); // digits of |coef_|, coef_ != 0
+		static std::int64_t exponent_gap(std::int64_t l_exp_, std::int64_t r_exp_); // l_exp_ - r_exp_, saturated
+		static bool add_exponents(std::int64_t l_exp_, std::int64_t r_exp_, std::int64_t& exp_); // false on overflow
 
 		// from str
 		static BigReal read_big_real(const std::string& str_, std::size_t st_p_);
+		// e[+-]digits: returns the end, first_ if there is no exponent, nullptr if it is out of range
+		static const char* read_exponent(const char* first_, const char* last_, std::int64_t& exp_);
 
-		std::vector<std::int8_t> b_whole_part;
-		std::vector<std::int8_t> b_fractional_part;
+		BigInt b_coef; // signed, val = b_coef * 10^b_exp
+		std::int64_t b_exp; // zero if b_coef is zero
 		std::size_t b_am_dig_after_com; // for cout, division...
-		bool b_is_neg;
 	};
+
+	// std::to_chars / std::from_chars conventions (from_chars reuses the limbs of val_)
+	// text of to_string(); short buffer: ret { last_, std::errc::value_too_large }
+	std::to_chars_result to_chars(char* first_, char* last_, const BigReal& val_);
+	// [-]digits[.digits][e[+-]digits], at least one digit; error: ret { first_, std::errc::invalid_argument },
+	// exponent beyond int64 (also after the fractional digits): ret { first_, std::errc::result_out_of_range }
+	std::from_chars_result from_chars(const char* first_, const char* last_, BigReal& val_);
 }
@@ -0,0 +1,366 @@
+/*
+* /File: Binary.cpp /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <istream>
+#include <ostream>
+
+#include "Binary.h"
+#include "BigInt.h"
+#include "BigReal.h"
+
+
+namespace lez
+{
+
+// ----------------------------------------------------------------------------
+// views
+BigIntView::BigIntView() :
+	b_limbs(nullptr), b_size(0U), b_is_neg(false) // zero
+{
+}
+
+bool BigIntView::is_neg() const
+{
+	return b_is_neg;
+}
+
+bool BigIntView::is_zero() const
+{
+	for (std::size_t i = 0U; i < b_size; ++i)
+		if (limb(i) != 0U)
+			return false;
+	return true;
+}
+
+std::size_t BigIntView::size() const
+{
+	return b_size;
+}
+
+std::uint32_t BigIntView::limb(std::size_t pos_) const
+{
+	const std::uint8_t* ptr = b_limbs + 4U * pos_;
+	return static_cast<std::uint32_t>(ptr[0]) | static_cast<std::uint32_t>(ptr[1]) << 8U |
+		static_cast<std::uint32_t>(ptr[2]) << 16U | static_cast<std::uint32_t>(ptr[3]) << 24U;
+}
+
+BigInt BigIntView::to_big_int() const
+{
+	BigInt res = BigInt::from_bytes(b_limbs, 4U * b_size, Endian::little);
+	if (b_is_neg && !res.is_zero())
+		res.set_neg();
+	return res;
+}
+
+BigRealView::BigRealView() :
+	b_exponent(0), b_am_dig_after_com(0U) // zero
+{
+}
+
+bool BigRealView::is_neg() const
+{
+	return b_mantissa.is_neg();
+}
+
+bool BigRealView::is_zero() const
+{
+	return b_mantissa.is_zero();
+}
+
+const BigIntView& BigRealView::mantissa() const
+{
+	return b_mantissa;
+}
+
+std::int64_t BigRealView::exponent() const
+{
+	return b_exponent;
+}
+
+std::size_t BigRealView::get_amount_digits_after_comma() const
+{
+	return b_am_dig_after_com;
+}
+
+BigReal BigRealView::to_big_real() const
+{
+	return to_big_real(b_mantissa.to_big_int(), b_exponent, b_am_dig_after_com);
+}
+
+BigReal BigRealView::to_big_real(BigInt mant_, std::int64_t exp_, std::size_t am_dig_after_com_)
+{
+	BigReal res = BigReal::to_big_real(std::move(mant_), exp_);
+	res.set_amount_digits_after_comma(am_dig_after_com_);
+	return res;
+}
+
+
+// ----------------------------------------------------------------------------
+// writer
+BinaryWriter::BinaryWriter()
+{
+}
+
+void BinaryWriter::write(const BigInt& val_)
+{
+	b_buf.push_back(static_cast<std::uint8_t>(version << 4U | (val_.is_neg() ? 1U : 0U)));
+	write_limbs(val_);
+}
+
+void BinaryWriter::write(const BigReal& val_)
+{
+	// mantissa = coefficient, exponent = its scale
+	std::int64_t exp = val_.exponent();
+	b_buf.push_back(static_cast<std::uint8_t>(version << 4U | 2U | (val_.is_neg() ? 1U : 0U)));
+	write_varint(static_cast<std::uint64_t>(val_.get_amount_digits_after_comma()));
+	write_varint(static_cast<std::uint64_t>(exp) << 1U ^ static_cast<std::uint64_t>(exp >> 63)); // zigzag
+	write_limbs(val_.coefficient());
+}
+
+const std::vector<std::uint8_t>& BinaryWriter::buffer() const
+{
+	return b_buf;
+}
+
+std::vector<std::uint8_t> BinaryWriter::release()
+{
+	std::vector<std::uint8_t> res;
+	res.swap(b_buf);
+	return res;
+}
+
+void BinaryWriter::clear()
+{
+	b_buf.clear();
+}
+
+void BinaryWriter::write_varint(std::uint64_t val_)
+{
+	while (val_ >= 0x80U)
+	{
+		b_buf.push_back(static_cast<std::uint8_t>(val_ | 0x80U));
+		val_ >>= 7U;
+	}
+	b_buf.push_back(static_cast<std::uint8_t>(val_));
+}
+
+void BinaryWriter::write_limbs(const BigInt& val_)
+{
+	std::size_t size = (val_.bit_length() + 31U) / 32U;
+	write_varint(static_cast<std::uint64_t>(size));
+	if (size == 0U)
+		return;
+	std::size_t pos = b_buf.size();
+	b_buf.resize(pos + 4U * size);
+	val_.export_to(b_buf.data() + pos, 4U * size, Endian::little); // |val|
+}
+
+std::ostream& write_binary(std::ostream& stream_, const BigInt& val_)
+{
+	BinaryWriter wr;
+	wr.write(val_);
+	return stream_.write(reinterpret_cast<const char*>(wr.b_buf.data()),
+		static_cast<std::streamsize>(wr.b_buf.size()));
+}
+
+std::ostream& write_binary(std::ostream& stream_, const BigReal& val_)
+{
+	BinaryWriter wr;
+	wr.write(val_);
+	return stream_.write(reinterpret_cast<const char*>(wr.b_buf.data()),
+		static_cast<std::streamsize>(wr.b_buf.size()));
+}
+
+
+// ----------------------------------------------------------------------------
+// reader
+BinaryReader::BinaryReader(const std::uint8_t* data_, std::size_t size_) :
+	b_first(data_), b_cur(data_), b_last(data_ + size_)
+{
+}
+
+bool BinaryReader::read(BigInt& val_)
+{
+	BigIntView view;
+	if (!read(view))
+		return false;
+	val_ = view.to_big_int();
+	return true;
+}
+
+bool BinaryReader::read(BigReal& val_)
+{
+	BigRealView view;
+	if (!read(view))
+		return false;
+	val_ = view.to_big_real();
+	return true;
+}
+
+bool BinaryReader::read(BigIntView& val_)
+{
+	BigRealView view;
+	if (!read_view(false, view))
+		return false;
+	val_ = view.b_mantissa;
+	return true;
+}
+
+bool BinaryReader::read(BigRealView& val_)
+{
+	return read_view(true, val_);
+}
+
+bool BinaryReader::is_end() const
+{
+	return b_cur == b_last;
+}
+
+std::size_t BinaryReader::position() const
+{
+	return static_cast<std::size_t>(b_cur - b_first);
+}
+
+bool BinaryReader::read_view(bool is_real_, BigRealView& val_)
+{
+	const std::uint8_t* cur = b_cur;
+	bool is_neg = false;
+	std::uint64_t am_dig_after_com = 0U;
+	std::int64_t exp = 0;
+	std::uint64_t size = 0U;
+	if (!read_header(cur, b_last, is_real_, is_neg, am_dig_after_com, exp, size))
+		return false;
+	if (size > static_cast<std::uint64_t>(b_last - cur) / 4U) // truncated
+		return false;
+	val_.b_mantissa.b_limbs = cur;
+	val_.b_mantissa.b_size = static_cast<std::size_t>(size);
+	val_.b_mantissa.b_is_neg = is_neg;
+	val_.b_exponent = exp;
+	val_.b_am_dig_after_com = static_cast<std::size_t>(am_dig_after_com);
+	b_cur = cur + 4U * size;
+	return true;
+}
+
+bool BinaryReader::read_varint(const std::uint8_t*& first_, const std::uint8_t* last_, std::uint64_t& val_)
+{
+	val_ = 0U;
+	for (std::size_t shift = 0U; shift < 64U; shift += 7U)
+	{
+		if (first_ == last_)
+			return false;
+		std::uint64_t byte = *first_++;
+		if (shift == 63U && byte > 1U) // overflow
+			return false;
+		val_ |= (byte & 0x7FU) << shift;
+		if (byte < 0x80U)
+			return true;
+	}
+	return false;
+}
+
+bool BinaryReader::read_header(const std::uint8_t*& first_, const std::uint8_t* last_, bool is_real_,
+	bool& is_neg_, std::uint64_t& am_dig_after_com_, std::int64_t& exp_, std::uint64_t& size_)
+{
+	const std::uint8_t* cur = first_;
+	if (cur == last_)
+		return false;
+	std::uint8_t tag = *cur++;
+	if ((tag >> 4U) != BinaryWriter::version || (tag & 0x0CU) != 0U)
+		return false;
+	is_neg_ = (tag & 1U) != 0U;
+	am_dig_after_com_ = is_real_ ? BigReal::start_amount_digits_after_comma() : 0U; // BigInt as BigReal
+	exp_ = 0;
+	if ((tag & 2U) != 0U) // BigReal
+	{
+		std::uint64_t zz = 0U;
+		if (!is_real_ || !read_varint(cur, last_, am_dig_after_com_) || !read_varint(cur, last_, zz))
+			return false;
+		exp_ = static_cast<std::int64_t>(zz >> 1U) ^ -static_cast<std::int64_t>(zz & 1U);
+	}
+	if (!read_varint(cur, last_, size_))
+		return false;
+	first_ = cur;
+	return true;
+}
+
+bool BinaryReader::read_header(std::istream& stream_, bool is_real_,
+	bool& is_neg_, std::uint64_t& am_dig_after_com_, std::int64_t& exp_, std::uint64_t& size_)
+{
+	std::uint8_t buf[31]; // tag + up to three varints, raw
+	std::size_t size = 0U;
+	std::size_t am_varints = 1U;
+	for (std::size_t i = 0U; i < am_varints + 1U; ++i)
+	{
+		std::size_t first = size;
+		do
+		{
+			std::istream::int_type ch = stream_.get();
+			if (ch == std::istream::traits_type::eof())
+				return false;
+			buf[size++] = static_cast<std::uint8_t>(ch);
+		} while (i != 0U && buf[size - 1U] >= 0x80U && size - first < 10U);
+		if (i == 0U && (buf[0] & 2U) != 0U) // BigReal
+			am_varints = 3U;
+	}
+	const std::uint8_t* first = buf;
+	return read_header(first, buf + size, is_real_, is_neg_, am_dig_after_com_, exp_, size_);
+}
+
+bool BinaryReader::read_stream(std::istream& stream_, bool is_real_, BigRealView& val_, std::vector<std::uint8_t>& buf_)
+{
+	bool is_neg = false;
+	std::uint64_t am_dig_after_com = 0U;
+	std::int64_t exp = 0;
+	std::uint64_t size = 0U;
+	if (!read_header(stream_, is_real_, is_neg, am_dig_after_com, exp, size))
+		return false;
+	if (size > std::numeric_limits<std::size_t>::max() / 4U) // the bytes could not be addressed
+		return false;
+	const std::uint64_t chunk = 1U << 20U; // don't trust the length with memory up front
+	buf_.clear();
+	while (static_cast<std::uint64_t>(buf_.size()) / 4U < size)
+	{
+		std::size_t pos = buf_.size();
+		std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(chunk, 4U * size - pos));
+		buf_.resize(pos + len);
+		if (!stream_.read(reinterpret_cast<char*>(buf_.data() + pos), static_cast<std::streamsize>(len)))
+			return false;
+	}
+	val_.b_mantissa.b_limbs = buf_.data();
+	val_.b_mantissa.b_size = static_cast<std::size_t>(size);
+	val_.b_mantissa.b_is_neg = is_neg;
+	val_.b_exponent = exp;
+	val_.b_am_dig_after_com = static_cast<std::size_t>(am_dig_after_com);
+	return true;
+}
+
+std::istream& read_binary(std::istream& stream_, BigInt& val_)
+{
+	BigRealView view;
+	std::vector<std::uint8_t> buf;
+	if (BinaryReader::read_stream(stream_, false, view, buf))
+		val_ = view.mantissa().to_big_int();
+	else
+		stream_.setstate(std::ios_base::failbit);
+	return stream_;
+}
+
+std::istream& read_binary(std::istream& stream_, BigReal& val_)
+{
+	BigRealView view;
+	std::vector<std::uint8_t> buf;
+	if (BinaryReader::read_stream(stream_, true, view, buf))
+		val_ = view.to_big_real();
+	else
+		stream_.setstate(std::ios_base::failbit);
+	return stream_;
+}
+
+} // end nmspc
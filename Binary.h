@@ -0,0 +1,127 @@
+#pragma once
+/*
+* /File: Binary.h /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+
+
+namespace lez
+{
+	class BigInt; // forward declaration
+	class BigReal;
+
+	// binary format, version 1 (all multi-byte values little-endian):
+	// tag = version << 4 | is_real << 1 | is_neg
+	// BigInt: tag, varint limb count, 32-bit limbs of |val|
+	// BigReal: tag, varint digits after comma, zigzag varint exponent, varint limb count, 32-bit limbs
+	//     value = mantissa * 10^exponent
+	// varint: 7 bits per byte, low group first, high bit = more
+
+	class BigIntView // zero-copy, valid while the buffer lives
+	{
+	public:
+		BigIntView();
+
+		bool is_neg() const;
+		bool is_zero() const;
+		std::size_t size() const; // limbs
+		std::uint32_t limb(std::size_t pos_) const; // little-endian order
+		BigInt to_big_int() const;
+
+	private:
+		friend class BinaryReader;
+
+		const std::uint8_t* b_limbs;
+		std::size_t b_size;
+		bool b_is_neg;
+	};
+
+	class BigRealView // zero-copy, valid while the buffer lives
+	{
+	public:
+		BigRealView();
+
+		bool is_neg() const;
+		bool is_zero() const;
+		const BigIntView& mantissa() const; // signed
+		std::int64_t exponent() const; // decimal
+		std::size_t get_amount_digits_after_comma() const;
+		BigReal to_big_real() const;
+
+	private:
+		friend class BinaryReader;
+
+		static BigReal to_big_real(BigInt mant_, std::int64_t exp_, std::size_t am_dig_after_com_);
+
+		BigIntView b_mantissa;
+		std::int64_t b_exponent;
+		std::size_t b_am_dig_after_com;
+	};
+
+	class BinaryWriter // appends to its own buffer
+	{
+	public:
+		BinaryWriter();
+
+		void write(const BigInt& val_);
+		void write(const BigReal& val_);
+		const std::vector<std::uint8_t>& buffer() const;
+		std::vector<std::uint8_t> release(); // and clear
+		void clear();
+
+		friend std::ostream& write_binary(std::ostream& stream_, const BigInt& val_);
+		friend std::ostream& write_binary(std::ostream& stream_, const BigReal& val_);
+
+		static const std::uint8_t version = 1U;
+
+	private:
+
+		void write_varint(std::uint64_t val_);
+		void write_limbs(const BigInt& val_);
+
+		std::vector<std::uint8_t> b_buf;
+	};
+
+	class BinaryReader // over a borrowed buffer; on failure the position is kept
+	// a BigInt record reads as BigReal too (start_amount_digits_after_comma()), not the other way round
+	{
+	public:
+		BinaryReader(const std::uint8_t* data_, std::size_t size_);
+
+		bool read(BigInt& val_);
+		bool read(BigReal& val_);
+		bool read(BigIntView& val_);
+		bool read(BigRealView& val_);
+		bool is_end() const;
+		std::size_t position() const; // bytes consumed
+
+		friend std::istream& read_binary(std::istream& stream_, BigInt& val_);
+		friend std::istream& read_binary(std::istream& stream_, BigReal& val_);
+
+	private:
+
+		static bool read_varint(const std::uint8_t*& first_, const std::uint8_t* last_, std::uint64_t& val_);
+		static bool read_header(const std::uint8_t*& first_, const std::uint8_t* last_, bool is_real_,
+			bool& is_neg_, std::uint64_t& am_dig_after_com_, std::int64_t& exp_, std::uint64_t& size_);
+		static bool read_header(std::istream& stream_, bool is_real_,
+			bool& is_neg_, std::uint64_t& am_dig_after_com_, std::int64_t& exp_, std::uint64_t& size_);
+		bool read_view(bool is_real_, BigRealView& val_);
+		static bool read_stream(std::istream& stream_, bool is_real_, BigRealView& val_, std::vector<std::uint8_t>& buf_);
+
+		const std::uint8_t* b_first;
+		const std::uint8_t* b_cur;
+		const std::uint8_t* b_last;
+	};
+
+	// single value, same format; read_binary sets failbit if malformed
+	std::ostream& write_binary(std::ostream& stream_, const BigInt& val_);
+	std::ostream& write_binary(std::ostream& stream_, const BigReal& val_);
+	std::istream& read_binary(std::istream& stream_, BigInt& val_);
+	std::istream& read_binary(std::istream& stream_, BigReal& val_);
+}
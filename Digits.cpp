@@ -0,0 +1,389 @@
+/*
+* /File: Digits.cpp /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include "Digits.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define LEZ_DIGITS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define LEZ_TARGET_SSE41
+#define LEZ_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define LEZ_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define LEZ_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+
+namespace lez
+{
+
+// ----------------------------------------------------------------------------
+// scalar
+static const char* skip_digits_scalar(const char* first_, const char* last_)
+{
+	while (first_ != last_ && static_cast<unsigned char>(*first_ - '0') < 10U) // one comparison
+		++first_;
+	return first_;
+}
+
+static void parse_groups_scalar(const char* first_, std::size_t am_, std::uint32_t* vals_)
+{
+	for (std::size_t i = 0U; i < am_; ++i, first_ += 8)
+	{
+		std::uint32_t val = 0U;
+		for (std::size_t j = 0U; j < 8U; ++j)
+			val = val * 10U + static_cast<std::uint32_t>(first_[j] - '0');
+		vals_[i] = val;
+	}
+}
+
+static void format_groups_scalar(const std::uint32_t* vals_, std::size_t am_, char* first_)
+{
+	for (std::size_t i = 0U; i < am_; ++i, first_ += 8)
+	{
+		std::uint32_t val = vals_[i];
+		for (std::size_t j = 8U; j-- != 0U; val /= 10U)
+			first_[j] = static_cast<char>('0' + val % 10U);
+	}
+}
+
+
+#ifdef LEZ_DIGITS_X86
+// ----------------------------------------------------------------------------
+// x86
+static void cpuid(int regs_[4], int leaf_, int sub_)
+{
+#if defined(_MSC_VER)
+	__cpuidex(regs_, leaf_, sub_);
+#else
+	unsigned int a = 0U, b = 0U, c = 0U, d = 0U;
+	__cpuid_count(static_cast<unsigned int>(leaf_), static_cast<unsigned int>(sub_), a, b, c, d);
+	regs_[0] = static_cast<int>(a);
+	regs_[1] = static_cast<int>(b);
+	regs_[2] = static_cast<int>(c);
+	regs_[3] = static_cast<int>(d);
+#endif
+}
+
+static std::uint64_t xgetbv()
+{
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	std::uint32_t lo = 0U, hi = 0U;
+	__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return static_cast<std::uint64_t>(hi) << 32U | lo;
+#endif
+}
+
+static unsigned int lowest_bit(std::uint32_t mask_) // mask_ != 0
+{
+#if defined(_MSC_VER)
+	unsigned long pos = 0U;
+	_BitScanForward(&pos, mask_);
+	return static_cast<unsigned int>(pos);
+#else
+	return static_cast<unsigned int>(__builtin_ctz(mask_));
+#endif
+}
+
+LEZ_TARGET_SSE41 static const char* skip_digits_sse41(const char* first_, const char* last_)
+{
+	const __m128i zero = _mm_set1_epi8('0');
+	const __m128i nine = _mm_set1_epi8('9');
+	for (; last_ - first_ >= 16; first_ += 16)
+	{
+		__m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first_));
+		// signed compares: bytes above 0x7F are below '0'
+		__m128i is_bad = _mm_or_si128(_mm_cmplt_epi8(chars, zero), _mm_cmpgt_epi8(chars, nine));
+		std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(is_bad));
+		if (mask != 0U)
+			return first_ + lowest_bit(mask);
+	}
+	return skip_digits_scalar(first_, last_);
+}
+
+LEZ_TARGET_AVX2 static const char* skip_digits_avx2(const char* first_, const char* last_)
+{
+	const __m256i zero = _mm256_set1_epi8('0');
+	const __m256i nine = _mm256_set1_epi8('9');
+	for (; last_ - first_ >= 32; first_ += 32)
+	{
+		__m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first_));
+		__m256i is_bad = _mm256_or_si256(_mm256_cmpgt_epi8(zero, chars), _mm256_cmpgt_epi8(chars, nine));
+		std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(is_bad));
+		if (mask != 0U)
+			return first_ + lowest_bit(mask);
+	}
+	return skip_digits_sse41(first_, last_);
+}
+
+// 16 digits: pairs (* 10 + 1), quads (* 100 + 1), octets (* 10000 + 1)
+LEZ_TARGET_SSE41 static void parse_groups_sse41(const char* first_, std::size_t am_, std::uint32_t* vals_)
+{
+	const __m128i zero = _mm_set1_epi8('0');
+	const __m128i mul_10 = _mm_set1_epi16(0x010A);
+	const __m128i mul_100 = _mm_set1_epi32(0x00010064);
+	const __m128i mul_10000 = _mm_set1_epi32(0x00012710);
+	for (; am_ >= 2U; am_ -= 2U, first_ += 16, vals_ += 2)
+	{
+		__m128i digs = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first_)), zero);
+		__m128i pairs = _mm_maddubs_epi16(digs, mul_10);
+		__m128i quads = _mm_madd_epi16(pairs, mul_100);
+		__m128i octets = _mm_madd_epi16(_mm_packus_epi32(quads, quads), mul_10000);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(vals_), octets);
+	}
+	parse_groups_scalar(first_, am_, vals_);
+}
+
+LEZ_TARGET_AVX2 static void parse_groups_avx2(const char* first_, std::size_t am_, std::uint32_t* vals_)
+{
+	const __m256i zero = _mm256_set1_epi8('0');
+	const __m256i mul_10 = _mm256_set1_epi16(0x010A);
+	const __m256i mul_100 = _mm256_set1_epi32(0x00010064);
+	const __m256i mul_10000 = _mm256_set1_epi32(0x00012710);
+	const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 0, 1, 4, 5); // octets of both lanes
+	for (; am_ >= 4U; am_ -= 4U, first_ += 32, vals_ += 4)
+	{
+		__m256i digs = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first_)), zero);
+		__m256i pairs = _mm256_maddubs_epi16(digs, mul_10);
+		__m256i quads = _mm256_madd_epi16(pairs, mul_100);
+		__m256i octets = _mm256_madd_epi16(_mm256_packus_epi32(quads, quads), mul_10000);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(vals_),
+			_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(octets, order)));
+	}
+	parse_groups_sse41(first_, am_, vals_);
+}
+
+// abcdefgh -> abcd, efgh -> 4 copies of each -> a, ab, abc, abcd by fixed-point multiplications -> digits
+LEZ_TARGET_SSE41 static __m128i octet_digits_sse41(std::uint32_t val_)
+{
+	const __m128i div_powers = _mm_setr_epi16(8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768);
+	const __m128i shift_powers = _mm_setr_epi16(1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768);
+	__m128i val = _mm_cvtsi32_si128(static_cast<int>(val_));
+	__m128i abcd = _mm_srli_epi64(_mm_mul_epu32(val, _mm_set1_epi32(static_cast<int>(0xD1B71759U))), 45);
+	__m128i efgh = _mm_sub_epi32(val, _mm_mul_epu32(abcd, _mm_set1_epi32(10000)));
+	__m128i halves = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+	__m128i copies = _mm_unpacklo_epi32(_mm_unpacklo_epi16(halves, halves), _mm_unpacklo_epi16(halves, halves));
+	__m128i prefixes = _mm_mulhi_epu16(_mm_mulhi_epu16(copies, div_powers), shift_powers);
+	return _mm_sub_epi16(prefixes, _mm_slli_epi64(_mm_mullo_epi16(prefixes, _mm_set1_epi16(10)), 16));
+}
+
+LEZ_TARGET_SSE41 static void format_groups_sse41(const std::uint32_t* vals_, std::size_t am_, char* first_)
+{
+	const __m128i zero = _mm_set1_epi8('0');
+	for (; am_ >= 2U; am_ -= 2U, vals_ += 2, first_ += 16)
+	{
+		__m128i digs = _mm_packus_epi16(octet_digits_sse41(vals_[0]), octet_digits_sse41(vals_[1]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(first_), _mm_add_epi8(digs, zero));
+	}
+	if (am_ != 0U)
+	{
+		__m128i digs = octet_digits_sse41(vals_[0]);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(first_), _mm_add_epi8(_mm_packus_epi16(digs, digs), zero));
+	}
+}
+
+// the same per 128-bit lane, two values
+LEZ_TARGET_AVX2 static __m256i octet_digits_avx2(std::uint32_t l_val_, std::uint32_t r_val_)
+{
+	const __m256i div_powers = _mm256_setr_epi16(8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768,
+		8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768);
+	const __m256i shift_powers = _mm256_setr_epi16(1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768,
+		1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768);
+	__m256i val = _mm256_setr_epi32(static_cast<int>(l_val_), 0, 0, 0, static_cast<int>(r_val_), 0, 0, 0);
+	__m256i abcd = _mm256_srli_epi64(_mm256_mul_epu32(val, _mm256_set1_epi32(static_cast<int>(0xD1B71759U))), 45);
+	__m256i efgh = _mm256_sub_epi32(val, _mm256_mul_epu32(abcd, _mm256_set1_epi32(10000)));
+	__m256i halves = _mm256_slli_epi64(_mm256_unpacklo_epi16(abcd, efgh), 2);
+	__m256i copies = _mm256_unpacklo_epi32(_mm256_unpacklo_epi16(halves, halves), _mm256_unpacklo_epi16(halves, halves));
+	__m256i prefixes = _mm256_mulhi_epu16(_mm256_mulhi_epu16(copies, div_powers), shift_powers);
+	return _mm256_sub_epi16(prefixes, _mm256_slli_epi64(_mm256_mullo_epi16(prefixes, _mm256_set1_epi16(10)), 16));
+}
+
+LEZ_TARGET_AVX2 static void format_groups_avx2(const std::uint32_t* vals_, std::size_t am_, char* first_)
+{
+	const __m256i zero = _mm256_set1_epi8('0');
+	for (; am_ >= 4U; am_ -= 4U, vals_ += 4, first_ += 32)
+	{
+		// lanes hold (0, 2) and (1, 3) after the pack
+		__m256i digs = _mm256_packus_epi16(octet_digits_avx2(vals_[0], vals_[1]), octet_digits_avx2(vals_[2], vals_[3]));
+		digs = _mm256_permute4x64_epi64(digs, 0xD8);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(first_), _mm256_add_epi8(digs, zero));
+	}
+	format_groups_sse41(vals_, am_, first_);
+}
+
+LEZ_TARGET_SSE41 static void to_values_sse41(const char* first_, std::size_t size_, std::int8_t* vals_)
+{
+	const __m128i zero = _mm_set1_epi8('0');
+	std::size_t i = 0U;
+	for (; i + 16U <= size_; i += 16U)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(vals_ + i),
+			_mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first_ + i)), zero));
+	for (; i < size_; ++i)
+		vals_[i] = static_cast<std::int8_t>(first_[i] - '0');
+}
+
+LEZ_TARGET_AVX2 static void to_values_avx2(const char* first_, std::size_t size_, std::int8_t* vals_)
+{
+	const __m256i zero = _mm256_set1_epi8('0');
+	std::size_t i = 0U;
+	for (; i + 32U <= size_; i += 32U)
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(vals_ + i),
+			_mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first_ + i)), zero));
+	to_values_sse41(first_ + i, size_ - i, vals_ + i);
+}
+
+LEZ_TARGET_SSE41 static void to_chars_sse41(const std::int8_t* vals_, std::size_t size_, char* first_)
+{
+	const __m128i zero = _mm_set1_epi8('0');
+	std::size_t i = 0U;
+	for (; i + 16U <= size_; i += 16U)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(first_ + i),
+			_mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(vals_ + i)), zero));
+	for (; i < size_; ++i)
+		first_[i] = static_cast<char>('0' + vals_[i]);
+}
+
+LEZ_TARGET_AVX2 static void to_chars_avx2(const std::int8_t* vals_, std::size_t size_, char* first_)
+{
+	const __m256i zero = _mm256_set1_epi8('0');
+	std::size_t i = 0U;
+	for (; i + 32U <= size_; i += 32U)
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(first_ + i),
+			_mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(vals_ + i)), zero));
+	to_chars_sse41(vals_ + i, size_ - i, first_ + i);
+}
+#endif
+
+
+// ----------------------------------------------------------------------------
+// dispatch
+Digits::Level& Digits::level()
+{
+	static Level level = detect_level();
+	return level;
+}
+
+Digits::Level Digits::detect_level()
+{
+#ifdef LEZ_DIGITS_X86
+	int regs[4] = { 0, 0, 0, 0 };
+	cpuid(regs, 0, 0);
+	int max_leaf = regs[0];
+	cpuid(regs, 1, 0);
+	bool has_sse41 = (regs[2] & (1 << 19)) != 0;
+	bool has_avx = (regs[2] & (1 << 27)) != 0 && (regs[2] & (1 << 28)) != 0 && (xgetbv() & 6U) == 6U; // OS saves ymm
+	bool has_avx2 = false;
+	if (has_avx && max_leaf >= 7)
+	{
+		cpuid(regs, 7, 0);
+		has_avx2 = (regs[1] & (1 << 5)) != 0;
+	}
+	if (has_avx2 && has_sse41)
+		return Level::avx2;
+	if (has_sse41)
+		return Level::sse41;
+#endif
+	return Level::scalar;
+}
+
+const char* Digits::skip_digits(const char* first_, const char* last_)
+{
+#ifdef LEZ_DIGITS_X86
+	switch (level())
+	{
+	case Level::avx2:
+		return skip_digits_avx2(first_, last_);
+	case Level::sse41:
+		return skip_digits_sse41(first_, last_);
+	default:
+		break;
+	}
+#endif
+	return skip_digits_scalar(first_, last_);
+}
+
+void Digits::parse_groups(const char* first_, std::size_t am_, std::uint32_t* vals_)
+{
+#ifdef LEZ_DIGITS_X86
+	switch (level())
+	{
+	case Level::avx2:
+		parse_groups_avx2(first_, am_, vals_);
+		return;
+	case Level::sse41:
+		parse_groups_sse41(first_, am_, vals_);
+		return;
+	default:
+		break;
+	}
+#endif
+	parse_groups_scalar(first_, am_, vals_);
+}
+
+void Digits::format_groups(const std::uint32_t* vals_, std::size_t am_, char* first_)
+{
+#ifdef LEZ_DIGITS_X86
+	switch (level())
+	{
+	case Level::avx2:
+		format_groups_avx2(vals_, am_, first_);
+		return;
+	case Level::sse41:
+		format_groups_sse41(vals_, am_, first_);
+		return;
+	default:
+		break;
+	}
+#endif
+	format_groups_scalar(vals_, am_, first_);
+}
+
+void Digits::to_values(const char* first_, std::size_t size_, std::int8_t* vals_)
+{
+#ifdef LEZ_DIGITS_X86
+	switch (level())
+	{
+	case Level::avx2:
+		to_values_avx2(first_, size_, vals_);
+		return;
+	case Level::sse41:
+		to_values_sse41(first_, size_, vals_);
+		return;
+	default:
+		break;
+	}
+#endif
+	for (std::size_t i = 0U; i < size_; ++i)
+		vals_[i] = static_cast<std::int8_t>(first_[i] - '0');
+}
+
+void Digits::to_chars(const std::int8_t* vals_, std::size_t size_, char* first_)
+{
+#ifdef LEZ_DIGITS_X86
+	switch (level())
+	{
+	case Level::avx2:
+		to_chars_avx2(vals_, size_, first_);
+		return;
+	case Level::sse41:
+		to_chars_sse41(vals_, size_, first_);
+		return;
+	default:
+		break;
+	}
+#endif
+	for (std::size_t i = 0U; i < size_; ++i)
+		first_[i] = static_cast<char>('0' + vals_[i]);
+}
+
+} // end nmspc
@@ -0,0 +1,38 @@
+#pragma once
+/*
+* /File: Digits.h /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace lez
+{
+	// ascii digit kernels for the text conversions: SSE4.1 (16 digits) or AVX2 (32 digits),
+	// picked by cpuid at the first use, portable scalar code otherwise
+
+	class Digits
+	{
+	public:
+		enum class Level { scalar, sse41, avx2 };
+
+		static Level& level(); // lval, detected once; may be lowered (tests, benchmarks), never raised
+
+		static const char* skip_digits(const char* first_, const char* last_); // first non-digit or last_
+		// am_ groups of 8 digits -> values < 10^8
+		static void parse_groups(const char* first_, std::size_t am_, std::uint32_t* vals_);
+		// am_ values < 10^8 -> am_ * 8 digits, leading zeros kept
+		static void format_groups(const std::uint32_t* vals_, std::size_t am_, char* first_);
+		// '0'..'9' <-> 0..9, no checks
+		static void to_values(const char* first_, std::size_t size_, std::int8_t* vals_);
+		static void to_chars(const std::int8_t* vals_, std::size_t size_, char* first_);
+
+	private:
+
+		static Level detect_level();
+	};
+}
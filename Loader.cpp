@@ -0,0 +1,304 @@
+/*
+* /File: Loader.cpp /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <utility>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <system_error>
+#include <iterator>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "Loader.h"
+#include "BigInt.h"
+#include "BigReal.h"
+
+
+namespace lez
+{
+
+// ----------------------------------------------------------------------------
+// mapped file
+MappedFile::MappedFile() :
+	b_data(nullptr), b_size(0U), b_is_open(false),
+#ifdef _WIN32
+	b_file(INVALID_HANDLE_VALUE), b_mapping(nullptr)
+#else
+	b_fd(-1)
+#endif
+{
+}
+
+MappedFile::MappedFile(const std::string& path_) :
+	MappedFile()
+{
+	open(path_);
+}
+
+MappedFile::MappedFile(MappedFile&& val_) :
+	MappedFile()
+{
+	swap(*this, val_);
+}
+
+MappedFile& MappedFile::operator=(MappedFile val_)
+{
+	swap(*this, val_);
+	return *this;
+}
+
+bool MappedFile::open(const std::string& path_)
+{
+	close();
+#ifdef _WIN32
+	b_file = CreateFileA(path_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (b_file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(b_file, &size))
+	{
+		close();
+		return false;
+	}
+	b_size = static_cast<std::size_t>(size.QuadPart);
+	b_is_open = true;
+	if (b_size == 0U) // empty files can't be mapped
+		return true;
+	b_mapping = CreateFileMappingA(b_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (b_mapping != nullptr)
+		b_data = static_cast<const char*>(MapViewOfFile(b_mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+	b_fd = ::open(path_.c_str(), O_RDONLY);
+	if (b_fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(b_fd, &st) != 0)
+	{
+		close();
+		return false;
+	}
+	b_size = static_cast<std::size_t>(st.st_size);
+	b_is_open = true;
+	if (b_size == 0U) // empty files can't be mapped
+		return true;
+	void* ptr = mmap(nullptr, b_size, PROT_READ, MAP_PRIVATE, b_fd, 0);
+	if (ptr != MAP_FAILED)
+	{
+		madvise(ptr, b_size, MADV_SEQUENTIAL);
+		b_data = static_cast<const char*>(ptr);
+	}
+#endif
+	if (b_data == nullptr)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (b_data != nullptr)
+		UnmapViewOfFile(b_data);
+	if (b_mapping != nullptr)
+		CloseHandle(b_mapping);
+	if (b_file != INVALID_HANDLE_VALUE)
+		CloseHandle(b_file);
+	b_file = INVALID_HANDLE_VALUE;
+	b_mapping = nullptr;
+#else
+	if (b_data != nullptr)
+		munmap(const_cast<char*>(b_data), b_size);
+	if (b_fd >= 0)
+		::close(b_fd);
+	b_fd = -1;
+#endif
+	b_data = nullptr;
+	b_size = 0U;
+	b_is_open = false;
+}
+
+bool MappedFile::is_open() const
+{
+	return b_is_open;
+}
+
+const char* MappedFile::data() const
+{
+	return b_data;
+}
+
+std::size_t MappedFile::size() const
+{
+	return b_size;
+}
+
+void MappedFile::swap(MappedFile& l_val_, MappedFile& r_val_)
+{
+	using std::swap;
+	swap(l_val_.b_data, r_val_.b_data);
+	swap(l_val_.b_size, r_val_.b_size);
+	swap(l_val_.b_is_open, r_val_.b_is_open);
+#ifdef _WIN32
+	swap(l_val_.b_file, r_val_.b_file);
+	swap(l_val_.b_mapping, r_val_.b_mapping);
+#else
+	swap(l_val_.b_fd, r_val_.b_fd);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+
+// ----------------------------------------------------------------------------
+// loader
+bool Loader::load_big_ints(const std::string& path_, std::vector<BigInt>& vals_)
+{
+	vals_.clear();
+	MappedFile file(path_);
+	if (!file.is_open())
+		return false;
+	return parse_numbers(file.data(), file.data() + file.size(), vals_);
+}
+
+bool Loader::load_big_reals(const std::string& path_, std::vector<BigReal>& vals_)
+{
+	vals_.clear();
+	MappedFile file(path_);
+	if (!file.is_open())
+		return false;
+	return parse_numbers(file.data(), file.data() + file.size(), vals_);
+}
+
+bool Loader::parse_big_ints(const char* first_, const char* last_, std::vector<BigInt>& vals_)
+{
+	return parse_numbers(first_, last_, vals_);
+}
+
+bool Loader::parse_big_reals(const char* first_, const char* last_, std::vector<BigReal>& vals_)
+{
+	return parse_numbers(first_, last_, vals_);
+}
+
+std::size_t& Loader::min_chunk_size()
+{
+	static std::size_t min_chunk_size = 1U << 20U;
+	return min_chunk_size;
+}
+
+template<class T>
+bool Loader::parse_numbers(const char* first_, const char* last_, std::vector<T>& vals_)
+{
+	vals_.clear();
+	std::size_t size = static_cast<std::size_t>(last_ - first_);
+	std::size_t am_chunks = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1U),
+		size / std::max<std::size_t>(min_chunk_size(), 1U));
+	if (am_chunks < 2U)
+	{
+		if (!parse_chunk(first_, last_, vals_))
+		{
+			vals_.clear();
+			return false;
+		}
+		return true;
+	}
+	// chunk borders are moved forward to whitespace, so no token is split
+	std::vector<const char*> borders(am_chunks + 1U, last_);
+	borders[0] = first_;
+	for (std::size_t i = 1U; i < am_chunks; ++i)
+	{
+		const char* it = std::max(first_ + size / am_chunks * i, borders[i - 1U]);
+		while (it != last_ && !is_space(*it))
+			++it;
+		borders[i] = it;
+	}
+	std::vector<std::vector<T>> parts(am_chunks);
+	std::vector<char> is_ok(am_chunks, 0);
+	std::exception_ptr error; // as in BigInt::parallel_for: first one wins, rethrown after the joins
+	std::mutex error_mutex;
+	auto work = [&](std::size_t i_) {
+		try
+		{
+			is_ok[i_] = parse_chunk(borders[i_], borders[i_ + 1U], parts[i_]) ? 1 : 0;
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(error_mutex);
+			if (!error)
+				error = std::current_exception();
+		}
+	};
+	std::vector<std::thread> threads;
+	threads.reserve(am_chunks - 1U);
+	for (std::size_t i = 1U; i < am_chunks; ++i)
+	{
+		try
+		{
+			threads.emplace_back(work, i);
+		}
+		catch (const std::system_error&)
+		{
+			work(i); // no thread to be had: this chunk here
+		}
+	}
+	work(0U);
+	for (auto& thread : threads)
+		thread.join();
+	if (error)
+		std::rethrow_exception(error);
+	if (std::find(is_ok.begin(), is_ok.end(), 0) != is_ok.end())
+		return false;
+	std::size_t am_vals = 0U;
+	for (const auto& part : parts)
+		am_vals += part.size();
+	vals_.reserve(am_vals);
+	for (auto& part : parts)
+		std::move(part.begin(), part.end(), std::back_inserter(vals_));
+	return true;
+}
+
+template<class T>
+bool Loader::parse_chunk(const char* first_, const char* last_, std::vector<T>& vals_)
+{
+	const char* it = first_;
+	while (true)
+	{
+		while (it != last_ && is_space(*it))
+			++it;
+		if (it == last_)
+			return true;
+		vals_.emplace_back();
+		auto res = from_chars(it, last_, vals_.back());
+		if (res.ec != std::errc() || (res.ptr != last_ && !is_space(*res.ptr)))
+			return false;
+		it = res.ptr;
+	}
+}
+
+bool Loader::is_space(char ch_)
+{
+	return ch_ == ' ' || ch_ == '\n' || ch_ == '\r' || ch_ == '\t' || ch_ == '\v' || ch_ == '\f';
+}
+
+} // end nmspc
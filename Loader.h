@@ -0,0 +1,72 @@
+#pragma once
+/*
+* /File: Loader.h /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <vector>
+#include <string>
+
+
+namespace lez
+{
+	class BigInt; // forward declaration
+	class BigReal;
+
+	class MappedFile // read-only mapping of a whole file
+	{
+	public:
+		MappedFile();
+		explicit MappedFile(const std::string& path_);
+		MappedFile(MappedFile&& val_);
+		MappedFile(const MappedFile& val_) = delete;
+
+		MappedFile& operator=(MappedFile val_);
+
+		bool open(const std::string& path_); // false if it can't be mapped
+		void close();
+		bool is_open() const;
+		const char* data() const;
+		std::size_t size() const;
+
+		static void swap(MappedFile& l_val_, MappedFile& r_val_);
+
+		~MappedFile();
+
+	private:
+
+		const char* b_data;
+		std::size_t b_size;
+		bool b_is_open;
+#ifdef _WIN32
+		void* b_file; // HANDLE
+		void* b_mapping; // HANDLE
+#else
+		int b_fd;
+#endif
+	};
+
+	// decimal numbers separated by whitespace, parsed in place (from_chars) in parallel chunks;
+	// chunks end at whitespace, a long token is split by from_chars itself (both halves of its digits at once);
+	// false if the file can't be mapped or a token is not a number, vals_ is then empty
+	class Loader
+	{
+	public:
+		static bool load_big_ints(const std::string& path_, std::vector<BigInt>& vals_);
+		static bool load_big_reals(const std::string& path_, std::vector<BigReal>& vals_);
+		static bool parse_big_ints(const char* first_, const char* last_, std::vector<BigInt>& vals_);
+		static bool parse_big_reals(const char* first_, const char* last_, std::vector<BigReal>& vals_);
+
+		static std::size_t& min_chunk_size(); // lval, bytes per thread, default = 1 MiB
+
+	private:
+
+		template<class T>
+		static bool parse_numbers(const char* first_, const char* last_, std::vector<T>& vals_);
+		template<class T>
+		static bool parse_chunk(const char* first_, const char* last_, std::vector<T>& vals_);
+		static bool is_space(char ch_);
+	};
+}
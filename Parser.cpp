@@ -0,0 +1,314 @@
+/*
+* /File: Parser.cpp /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <utility>
+#include <algorithm>
+#include <istream>
+#include <locale>
+#include <limits>
+
+#include "Parser.h"
+
+
+namespace lez
+{
+
+// ----------------------------------------------------------------------------
+// stream
+template<class T>
+static void read_token(std::istream& stream_, T& parser_)
+{
+	std::istream::sentry sentry(stream_); // skips whitespace
+	if (!sentry)
+		return;
+	const auto& ctype = std::use_facet<std::ctype<char>>(stream_.getloc());
+	std::streambuf* buf = stream_.rdbuf();
+	char chunk[4096];
+	std::size_t size = 0U;
+	bool is_taking = true;
+	while (true)
+	{
+		std::istream::int_type ch = buf->sgetc();
+		if (ch == std::istream::traits_type::eof())
+		{
+			stream_.setstate(std::ios_base::eofbit);
+			break;
+		}
+		if (ctype.is(std::ctype_base::space, std::istream::traits_type::to_char_type(ch)))
+			break;
+		buf->sbumpc();
+		if (!is_taking)
+			continue;
+		chunk[size++] = std::istream::traits_type::to_char_type(ch);
+		if (size == sizeof(chunk))
+		{
+			is_taking = parser_.feed(chunk, size) == size;
+			size = 0U;
+		}
+	}
+	if (is_taking && size != 0U)
+		parser_.feed(chunk, size);
+}
+
+
+// ----------------------------------------------------------------------------
+// BigInt
+BigIntParser::BigIntParser() :
+	b_am_dig(0U), b_state(State::start), b_is_neg(false)
+{
+	b_buf.reserve(block_size);
+}
+
+std::size_t BigIntParser::feed(const char* data_, std::size_t size_)
+{
+	if (b_state == State::done)
+		return 0U;
+	const char* it = data_;
+	const char* last = data_ + size_;
+	if (b_state == State::start)
+	{
+		while (it != last && (*it == ' ' || *it == '\n' || *it == '\r' || *it == '\t' || *it == '\v' || *it == '\f'))
+			++it;
+		if (it == last)
+			return size_;
+		b_state = State::sign;
+		if (*it == '-' || *it == '+')
+			b_is_neg = (*it++ == '-');
+	}
+	if (b_state == State::sign || b_state == State::digits)
+	{
+		while (it != last)
+		{
+			if (*it < '0' || *it > '9')
+			{
+				b_state = State::done;
+				break;
+			}
+			b_state = State::digits;
+			// digits up to the end of the block or of the data
+			std::size_t len = std::min<std::size_t>(block_size - b_buf.size(), static_cast<std::size_t>(last - it));
+			const char* end = it;
+			while (end != it + len && *end >= '0' && *end <= '9')
+				++end;
+			b_buf.insert(b_buf.end(), it, end);
+			b_am_dig += static_cast<std::size_t>(end - it);
+			it = end;
+			if (b_buf.size() == block_size)
+				push_block();
+		}
+	}
+	return static_cast<std::size_t>(it - data_);
+}
+
+bool BigIntParser::finish(BigInt& val_)
+{
+	if (b_am_dig == 0U)
+	{
+		reset();
+		return false;
+	}
+	val_ = combine_blocks();
+	val_.b_is_neg = b_is_neg && !val_.is_zero();
+	reset();
+	return true;
+}
+
+bool BigIntParser::is_done() const
+{
+	return b_state == State::done;
+}
+
+std::size_t BigIntParser::amount_digits() const
+{
+	return b_am_dig;
+}
+
+void BigIntParser::reset()
+{
+	b_buf.clear();
+	b_stack.clear();
+	b_am_dig = 0U;
+	b_state = State::start;
+	b_is_neg = false;
+}
+
+void BigIntParser::read(std::istream& stream_)
+{
+	read_token(stream_, *this);
+}
+
+void BigIntParser::push_block()
+{
+	BigInt block;
+	BigInt::simple_read_digits(b_buf.data(), b_buf.data() + b_buf.size(), block);
+	b_buf.clear();
+	std::size_t level = block_level;
+	while (!b_stack.empty() && b_stack.back().second == level)
+	{
+		block = BigInt::addition(BigInt::multiplication(b_stack.back().first, *BigInt::power_of_ten(level)), block);
+		b_stack.pop_back();
+		++level;
+	}
+	b_stack.emplace_back(std::move(block), level);
+}
+
+BigInt BigIntParser::combine_blocks()
+{
+	// from the lowest digits: acc = high * 10^(digits of acc) + acc, the buffer first
+	BigInt acc;
+	BigInt::simple_read_digits(b_buf.data(), b_buf.data() + b_buf.size(), acc);
+	BigInt power = BigInt::to_big_int(1); // 10^(digits of acc)
+	std::size_t len = b_buf.size();
+	for (; len >= 9U; len -= 9U)
+		BigInt::simple_multiplication(power, 1000000000U, 0U);
+	for (; len != 0U; --len)
+		BigInt::simple_multiplication(power, 10U, 0U);
+	while (!b_stack.empty())
+	{
+		acc = BigInt::addition(BigInt::multiplication(b_stack.back().first, power), acc);
+		if (b_stack.size() != 1U)
+			power = BigInt::multiplication(power, *BigInt::power_of_ten(b_stack.back().second));
+		b_stack.pop_back();
+	}
+	return acc;
+}
+
+BigIntParser::~BigIntParser()
+{
+}
+
+
+// ----------------------------------------------------------------------------
+// BigReal
+BigRealParser::BigRealParser() :
+	b_am_dig(0U), b_am_frac_dig(0U), b_exp_mag(0U), b_state(State::start), b_is_neg(false), b_is_exp_neg(false),
+	b_is_exp_overflow(false)
+{
+}
+
+std::size_t BigRealParser::feed(const char* data_, std::size_t size_)
+{
+	if (b_state == State::done)
+		return 0U;
+	const char* it = data_;
+	const char* last = data_ + size_;
+	if (b_state == State::start)
+	{
+		while (it != last && (*it == ' ' || *it == '\n' || *it == '\r' || *it == '\t' || *it == '\v' || *it == '\f'))
+			++it;
+		if (it == last)
+			return size_;
+		b_state = State::sign;
+		if (*it == '-' || *it == '+')
+			b_is_neg = (*it++ == '-');
+	}
+	for (; it != last && b_state != State::done; ++it)
+	{
+		bool is_digit = (*it >= '0' && *it <= '9');
+		if (b_state == State::exponent_mark || b_state == State::exponent_sign || b_state == State::exponent)
+		{
+			if (is_digit)
+			{
+				std::uint64_t dig = static_cast<std::uint64_t>(*it - '0');
+				b_is_exp_overflow = b_is_exp_overflow
+					|| b_exp_mag > (static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) - dig) / 10U;
+				b_exp_mag = b_exp_mag * 10U + dig;
+				b_state = State::exponent;
+			}
+			else if (b_state == State::exponent_mark && (*it == '-' || *it == '+'))
+			{
+				b_is_exp_neg = (*it == '-');
+				b_state = State::exponent_sign;
+			}
+			else
+				b_state = State::done;
+		}
+		else if (is_digit)
+		{
+			const char* end = it; // the whole run goes to the coefficient
+			while (end != last && *end >= '0' && *end <= '9')
+				++end;
+			std::size_t len = static_cast<std::size_t>(end - it);
+			b_coef.feed(it, len);
+			b_am_dig += len;
+			if (b_state == State::fractional)
+				b_am_frac_dig += len;
+			if (b_state == State::sign)
+				b_state = State::whole;
+			it = end - 1;
+		}
+		else if (*it == '.' && (b_state == State::sign || b_state == State::whole))
+			b_state = State::fractional;
+		else if ((*it == 'e' || *it == 'E') && b_am_dig != 0U)
+			b_state = State::exponent_mark;
+		else
+			b_state = State::done;
+	}
+	if (b_state == State::done)
+		--it; // the byte after the number is not taken
+	return static_cast<std::size_t>(it - data_);
+}
+
+bool BigRealParser::finish(BigReal& val_)
+{
+	if (b_am_dig == 0U || b_is_exp_overflow)
+	{
+		reset();
+		return false;
+	}
+	BigInt coef;
+	b_coef.finish(coef);
+	if (b_is_neg)
+		coef.set_neg();
+	std::int64_t exp = 0;
+	if (b_state != State::exponent_mark && b_state != State::exponent_sign)
+		exp = b_is_exp_neg ? -static_cast<std::int64_t>(b_exp_mag) : static_cast<std::int64_t>(b_exp_mag);
+	std::int64_t am_frac = static_cast<std::int64_t>(b_am_frac_dig);
+	if (coef.is_zero())
+		exp = am_frac = 0;
+	else if (exp < std::numeric_limits<std::int64_t>::min() + am_frac)
+	{
+		reset(); // exponent beyond int64 after the fractional digits
+		return false;
+	}
+	val_ = BigReal::to_big_real(std::move(coef), exp - am_frac);
+	reset();
+	return true;
+}
+
+bool BigRealParser::is_done() const
+{
+	return b_state == State::done;
+}
+
+std::size_t BigRealParser::amount_digits() const
+{
+	return b_am_dig;
+}
+
+void BigRealParser::reset()
+{
+	b_coef.reset();
+	b_am_dig = 0U;
+	b_am_frac_dig = 0U;
+	b_exp_mag = 0U;
+	b_state = State::start;
+	b_is_neg = false;
+	b_is_exp_neg = false;
+	b_is_exp_overflow = false;
+}
+
+void BigRealParser::read(std::istream& stream_)
+{
+	read_token(stream_, *this);
+}
+
+BigRealParser::~BigRealParser()
+{
+}
+
+} // end nmspc
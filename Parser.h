@@ -0,0 +1,84 @@
+#pragma once
+/*
+* /File: Parser.h /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+
+#include "BigInt.h"
+#include "BigReal.h"
+
+
+namespace lez
+{
+	// push parsers: the text comes in chunks of any size (sockets, pipes), no full copy of it is kept
+	// feed() skips leading whitespace, takes [-+]digits (BigReal: [-+]digits[.digits][e[+-]digits]) and returns
+	// the amount of bytes taken; less than size_ means the number has ended, the rest is not touched
+	// finish() gives the value and resets the parser, false if there were no digits
+
+	class BigIntParser
+	{
+	public:
+		BigIntParser();
+
+		std::size_t feed(const char* data_, std::size_t size_);
+		bool finish(BigInt& val_);
+		bool is_done() const; // a byte after the number was seen
+		std::size_t amount_digits() const;
+		void reset();
+		void read(std::istream& stream_); // one whitespace-delimited token, the tail after the number is skipped
+
+		~BigIntParser();
+
+	private:
+
+		void push_block(); // b_buf -> b_stack
+		BigInt combine_blocks(); // b_stack and b_buf -> value without the sign
+
+		// the buffer holds one block of digits at most, full blocks are merged like a binary counter:
+		// two blocks of 9 * 2^level digits make high * 10^(9 * 2^level) + low
+		static const std::size_t block_level = 9U; // 9 * 2^9 = 4608 digits
+		static const std::size_t block_size = 9U << block_level;
+
+		enum class State { start, sign, digits, done };
+
+		std::vector<char> b_buf;
+		std::vector<std::pair<BigInt, std::size_t>> b_stack; // (value, level), levels descend
+		std::size_t b_am_dig;
+		State b_state;
+		bool b_is_neg;
+	};
+
+	class BigRealParser
+	{
+	public:
+		BigRealParser();
+
+		std::size_t feed(const char* data_, std::size_t size_);
+		bool finish(BigReal& val_); // start_amount_digits_after_comma()
+		bool is_done() const; // a byte after the number was seen
+		std::size_t amount_digits() const;
+		void reset();
+		void read(std::istream& stream_); // one whitespace-delimited token, the tail after the number is skipped
+
+		~BigRealParser();
+
+	private:
+
+		enum class State { start, sign, whole, fractional, exponent_mark, exponent_sign, exponent, done };
+
+		BigIntParser b_coef; // all the digits, the comma is skipped
+		std::size_t b_am_dig;
+		std::size_t b_am_frac_dig;
+		std::uint64_t b_exp_mag; // e[+-]digits, an 'e' without digits is dropped
+		State b_state;
+		bool b_is_neg;
+		bool b_is_exp_neg;
+		bool b_is_exp_overflow;
+	};
+}
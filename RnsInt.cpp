@@ -0,0 +1,377 @@
+/*
+* /File: RnsInt.cpp /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <utility>
+#include <algorithm>
+#include <ostream>
+
+#include "RnsInt.h"
+#include "BigInt.h"
+
+
+namespace lez
+{
+
+RnsInt::RnsInt() :
+	b_res_vec(std::min(start_amount_moduli(), moduli().size()), 0U) // zero
+{
+}
+
+RnsInt::RnsInt(const RnsInt& val_) :
+	b_res_vec(val_.b_res_vec)
+{
+}
+
+RnsInt::RnsInt(RnsInt&& val_) :
+	b_res_vec(std::move(val_.b_res_vec))
+{
+}
+
+RnsInt::RnsInt(std::int32_t val_) :
+	RnsInt()
+{
+	*this = to_rns_int(static_cast<std::int64_t>(val_));
+}
+
+RnsInt::RnsInt(std::int64_t val_) :
+	RnsInt()
+{
+	*this = to_rns_int(val_);
+}
+
+RnsInt::RnsInt(const BigInt& val_) :
+	RnsInt()
+{
+	*this = to_rns_int(val_);
+}
+
+RnsInt& RnsInt::operator=(std::int32_t val_)
+{
+	*this = to_rns_int(static_cast<std::int64_t>(val_));
+	return *this;
+}
+
+RnsInt& RnsInt::operator=(std::int64_t val_)
+{
+	*this = to_rns_int(val_);
+	return *this;
+}
+
+RnsInt& RnsInt::operator=(const BigInt& val_)
+{
+	*this = to_rns_int(val_);
+	return *this;
+}
+
+RnsInt& RnsInt::operator=(RnsInt val_)
+{
+	RnsInt::swap(*this, val_);
+	return *this;
+}
+
+
+// ----------------------------------------------------------------------------
+// to type
+BigInt RnsInt::to_big_int() const
+{
+	// Garner: val = v_0 + v_1 * p_0 + v_2 * p_0 * p_1 + ..., 0 <= v_i < p_i
+	const std::vector<std::uint32_t>& mods = moduli();
+	std::size_t am = b_res_vec.size();
+	std::vector<std::uint32_t> mixed(am, 0U);
+	for (std::size_t i = 0U; i < am; ++i)
+	{
+		std::uint64_t mod = mods[i];
+		std::uint64_t acc = 0U; // v_0 + ... + v_i-1 * (p_0 * ... * p_i-2) mod p_i
+		std::uint64_t prod = 1U; // p_0 * ... * p_i-1 mod p_i
+		for (std::size_t j = 0U; j < i; ++j)
+		{
+			acc = (acc + mixed[j] * prod) % mod;
+			prod = prod * mods[j] % mod;
+		}
+		std::uint64_t diff = (b_res_vec[i] + mod - acc) % mod;
+		mixed[i] = static_cast<std::uint32_t>(diff *
+			pow_mod(static_cast<std::uint32_t>(prod), static_cast<std::uint32_t>(mod - 2U), mods[i]) % mod);
+	}
+	BigInt res;
+	BigInt full_mod(1);
+	for (std::size_t i = am; i != 0U; --i)
+	{
+		res *= static_cast<std::int64_t>(mods[i - 1U]);
+		res += static_cast<std::int64_t>(mixed[i - 1U]);
+		full_mod *= static_cast<std::int64_t>(mods[i - 1U]);
+	}
+	if (res * 2 >= full_mod) // symmetric range
+		res -= full_mod;
+	return res;
+}
+
+std::size_t RnsInt::amount_moduli() const
+{
+	return b_res_vec.size();
+}
+
+bool RnsInt::is_zero() const
+{
+	for (const auto& val : b_res_vec)
+		if (val != 0U)
+			return false;
+	return true;
+}
+
+void RnsInt::reset()
+{
+	*this = RnsInt();
+}
+
+RnsInt::operator BigInt() const
+{
+	return to_big_int();
+}
+
+
+// ----------------------------------------------------------------------------
+// arithmetic (digit-wise, no branches in loops)
+const RnsInt RnsInt::operator-() const
+{
+	RnsInt ri(*this);
+	const std::vector<std::uint32_t>& mods = moduli();
+	for (std::size_t i = 0U; i < ri.b_res_vec.size(); ++i)
+	{
+		std::uint32_t val = mods[i] - ri.b_res_vec[i];
+		ri.b_res_vec[i] = std::min(val, val - mods[i]); // p -> 0
+	}
+	return ri;
+}
+
+const RnsInt RnsInt::operator+() const
+{
+	return *this; // cp
+}
+
+const RnsInt RnsInt::operator+(const RnsInt& r_val_) const
+{
+	RnsInt ri(*this);
+	ri += r_val_;
+	return ri;
+}
+
+const RnsInt RnsInt::operator-(const RnsInt& r_val_) const
+{
+	RnsInt ri(*this);
+	ri -= r_val_;
+	return ri;
+}
+
+const RnsInt RnsInt::operator*(const RnsInt& r_val_) const
+{
+	RnsInt ri(*this);
+	ri *= r_val_;
+	return ri;
+}
+
+RnsInt& RnsInt::operator+=(const RnsInt& r_val_)
+{
+	const std::vector<std::uint32_t>& mods = moduli();
+	std::size_t am = common_amount_moduli(*this, r_val_);
+	b_res_vec.resize(am);
+	for (std::size_t i = 0U; i < am; ++i)
+	{
+		std::uint32_t val = b_res_vec[i] + r_val_.b_res_vec[i]; // < 2^32
+		b_res_vec[i] = std::min(val, val - mods[i]); // wraps if val < p
+	}
+	return *this;
+}
+
+RnsInt& RnsInt::operator-=(const RnsInt& r_val_)
+{
+	const std::vector<std::uint32_t>& mods = moduli();
+	std::size_t am = common_amount_moduli(*this, r_val_);
+	b_res_vec.resize(am);
+	for (std::size_t i = 0U; i < am; ++i)
+	{
+		std::uint32_t val = b_res_vec[i] - r_val_.b_res_vec[i];
+		b_res_vec[i] = std::min(val, val + mods[i]); // wraps back if there was a borrow
+	}
+	return *this;
+}
+
+RnsInt& RnsInt::operator*=(const RnsInt& r_val_)
+{
+	const std::vector<std::uint32_t>& mods = moduli();
+	std::size_t am = common_amount_moduli(*this, r_val_);
+	b_res_vec.resize(am);
+	for (std::size_t i = 0U; i < am; ++i)
+		b_res_vec[i] = static_cast<std::uint32_t>(
+			static_cast<std::uint64_t>(b_res_vec[i]) * r_val_.b_res_vec[i] % mods[i]);
+	return *this;
+}
+
+std::size_t RnsInt::common_amount_moduli(const RnsInt& l_val_, const RnsInt& r_val_)
+{
+	// different bases: result is exact modulo the smaller one
+	return std::min(l_val_.b_res_vec.size(), r_val_.b_res_vec.size());
+}
+
+
+// ----------------------------------------------------------------------------
+// comparisons
+bool RnsInt::operator==(const RnsInt& r_val_) const
+{
+	if (b_res_vec.size() != r_val_.b_res_vec.size())
+		return to_big_int() == r_val_.to_big_int(); // different bases: the values themselves
+	return b_res_vec == r_val_.b_res_vec;
+}
+
+bool RnsInt::operator!=(const RnsInt& r_val_) const
+{
+	return !operator==(r_val_);
+}
+
+
+// ----------------------------------------------------------------------------
+// stream
+std::ostream& RnsInt::operator<<(std::ostream& stream_) const
+{
+	stream_ << to_string();
+	return stream_;
+}
+
+std::string RnsInt::to_string() const
+{
+	return to_big_int().to_string();
+}
+
+std::ostream& operator<<(std::ostream& stream_, const RnsInt& ri_)
+{
+	return ri_.operator<<(stream_);
+}
+
+
+// ----------------------------------------------------------------------------
+// to rns int
+RnsInt RnsInt::to_rns_int(std::int64_t val_)
+{
+	RnsInt ri;
+	const std::vector<std::uint32_t>& mods = moduli();
+	// |val_| as unsigned, works for min too
+	std::uint64_t abs_val = (val_ < 0) ? 0U - static_cast<std::uint64_t>(val_) : static_cast<std::uint64_t>(val_);
+	for (std::size_t i = 0U; i < ri.b_res_vec.size(); ++i)
+	{
+		std::uint32_t res = static_cast<std::uint32_t>(abs_val % mods[i]);
+		ri.b_res_vec[i] = (val_ < 0 && res != 0U) ? mods[i] - res : res;
+	}
+	return ri;
+}
+
+RnsInt RnsInt::to_rns_int(const BigInt& val_)
+{
+	return to_rns_int(std::vector<BigInt>(1U, val_)).front();
+}
+
+std::vector<RnsInt> RnsInt::to_rns_int(const std::vector<BigInt>& vals_)
+{
+	std::vector<RnsInt> res(vals_.size());
+	if (vals_.empty())
+		return res;
+	const std::vector<std::uint32_t>& mods = moduli();
+	std::size_t am = res.front().b_res_vec.size();
+	std::vector<BigInt> bi_mods;
+	bi_mods.reserve(am);
+	for (std::size_t i = 0U; i < am; ++i)
+		bi_mods.push_back(BigInt(static_cast<std::int64_t>(mods[i])));
+	std::vector<std::vector<BigInt>> all_rems = BigInt::remainders(vals_, bi_mods); // one tree of the moduli
+	for (std::size_t j = 0U; j < vals_.size(); ++j)
+	{
+		const std::vector<BigInt>& rems = all_rems[j];
+		for (std::size_t i = 0U; i < am; ++i)
+		{
+			std::int64_t rem = rems[i].to_int64(); // sign of vals_[j]
+			res[j].b_res_vec[i] = static_cast<std::uint32_t>((rem < 0) ? rem + mods[i] : rem);
+		}
+	}
+	return res;
+}
+
+
+// ----------------------------------------------------------------------------
+// basis
+const std::vector<std::uint32_t>& RnsInt::moduli()
+{
+	// largest primes below 2^31: sum of two residues fits in 32 bits
+	static const std::vector<std::uint32_t> mods = []() {
+		const std::size_t max_am_moduli = 4096U;
+		std::vector<std::uint32_t> res;
+		res.reserve(max_am_moduli);
+		for (std::uint32_t val = 2147483647U; res.size() < max_am_moduli; val -= 2U)
+			if (is_prime(val))
+				res.push_back(val);
+		return res;
+	}();
+	return mods;
+}
+
+std::size_t& RnsInt::start_amount_moduli()
+{
+	static std::size_t start_am_moduli = 32U; // about 990 bits
+	return start_am_moduli;
+}
+
+std::uint32_t RnsInt::pow_mod(std::uint32_t base_, std::uint32_t exp_, std::uint32_t mod_)
+{
+	std::uint64_t res = 1U;
+	std::uint64_t base = base_ % mod_;
+	while (exp_ != 0U)
+	{
+		if (exp_ & 1U)
+			res = res * base % mod_;
+		base = base * base % mod_;
+		exp_ >>= 1U;
+	}
+	return static_cast<std::uint32_t>(res);
+}
+
+bool RnsInt::is_prime(std::uint32_t val_)
+{
+	if (val_ < 2U)
+		return false;
+	for (std::uint32_t p : { 2U, 3U, 5U, 7U, 61U })
+		if (val_ % p == 0U)
+			return val_ == p;
+	// Miller-Rabin, bases 2, 7, 61 are enough below 2^32
+	std::uint32_t d = val_ - 1U;
+	std::uint32_t s = 0U;
+	for (; (d & 1U) == 0U; d >>= 1U)
+		++s;
+	for (std::uint32_t a : { 2U, 7U, 61U })
+	{
+		std::uint64_t x = pow_mod(a, d, val_);
+		if (x == 1U || x == val_ - 1U)
+			continue;
+		bool is_composite = true;
+		for (std::uint32_t r = 1U; is_composite && r < s; ++r)
+		{
+			x = x * x % val_;
+			if (x == val_ - 1U)
+				is_composite = false;
+		}
+		if (is_composite)
+			return false;
+	}
+	return true;
+}
+
+void RnsInt::swap(RnsInt& l_val_, RnsInt& r_val_)
+{
+	using std::swap;
+	swap(l_val_.b_res_vec, r_val_.b_res_vec);
+}
+
+RnsInt::~RnsInt()
+{
+}
+
+} // end nmspc
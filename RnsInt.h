@@ -0,0 +1,80 @@
+#pragma once
+/*
+* /File: RnsInt.h /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <vector>
+#include <string>
+
+
+namespace lez
+{
+	class BigInt; // forward declaration
+
+	// residue number system: value by residues modulo fixed primes < 2^31
+	// start_amount_moduli() edit for all class, range is |val| < (p_0 * ... * p_k-1) / 2
+	// +, - and * are digit-wise (no carries), to_big_int() is CRT (Garner)
+
+	class RnsInt
+	{
+	public:
+		RnsInt();
+		RnsInt(const RnsInt& val_);
+		RnsInt(RnsInt&& val_);
+		explicit RnsInt(std::int32_t val_);
+		explicit RnsInt(std::int64_t val_);
+		explicit RnsInt(const BigInt& val_);
+
+		RnsInt& operator=(std::int32_t val_);
+		RnsInt& operator=(std::int64_t val_);
+		RnsInt& operator=(const BigInt& val_);
+		RnsInt& operator=(RnsInt val_);
+
+		BigInt to_big_int() const;
+		std::size_t amount_moduli() const;
+		bool is_zero() const;
+		void reset();
+
+		explicit operator BigInt() const;
+
+		const RnsInt operator-() const;
+		const RnsInt operator+() const;
+
+		const RnsInt operator+(const RnsInt& r_val_) const;
+		const RnsInt operator-(const RnsInt& r_val_) const;
+		const RnsInt operator*(const RnsInt& r_val_) const;
+
+		RnsInt& operator+=(const RnsInt& r_val_);
+		RnsInt& operator-=(const RnsInt& r_val_);
+		RnsInt& operator*=(const RnsInt& r_val_);
+
+		bool operator==(const RnsInt& r_val_) const; // different bases: by the values (CRT)
+		bool operator!=(const RnsInt& r_val_) const;
+
+		std::ostream& operator<<(std::ostream& stream_) const;
+		std::string to_string() const;
+
+		friend std::ostream& operator<<(std::ostream& stream_, const RnsInt& ri_);
+
+		static RnsInt to_rns_int(std::int64_t val_);
+		static RnsInt to_rns_int(const BigInt& val_);
+		static std::vector<RnsInt> to_rns_int(const std::vector<BigInt>& vals_);
+
+		static const std::vector<std::uint32_t>& moduli(); // all primes of the basis, descending
+		static std::size_t& start_amount_moduli(); // lval, for all class, default = 32U
+		static void swap(RnsInt& l_val_, RnsInt& r_val_);
+
+		~RnsInt();
+
+	private:
+
+		static std::uint32_t pow_mod(std::uint32_t base_, std::uint32_t exp_, std::uint32_t mod_);
+		static bool is_prime(std::uint32_t val_); // deterministic for 32 bits
+		static std::size_t common_amount_moduli(const RnsInt& l_val_, const RnsInt& r_val_);
+
+		std::vector<std::uint32_t> b_res_vec; // b_res_vec[i] = val mod moduli()[i]
+	};
+}
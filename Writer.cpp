@@ -0,0 +1,121 @@
+/*
+* /File: Writer.cpp /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <utility>
+#include <algorithm>
+#include <ostream>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Writer.h"
+#include "BigInt.h"
+#include "BigReal.h"
+
+
+namespace lez
+{
+
+StreamWriter::StreamWriter(Sink sink_, std::size_t chunk_size_) :
+	b_sink(std::move(sink_)),
+	b_chunk_size(std::max<std::size_t>(chunk_size_, 1U)),
+	b_is_good(true)
+{
+	b_buf.reserve(b_chunk_size);
+}
+
+StreamWriter::StreamWriter(std::ostream& stream_, std::size_t chunk_size_) :
+	StreamWriter([&stream_](const char* data_, std::size_t size_) {
+		return static_cast<bool>(stream_.write(data_, static_cast<std::streamsize>(size_)));
+	}, chunk_size_)
+{
+}
+
+StreamWriter::StreamWriter(int fd_, std::size_t chunk_size_) :
+	StreamWriter([fd_](const char* data_, std::size_t size_) {
+		while (size_ != 0U) // partial writes and signals
+		{
+#ifdef _WIN32
+			int len = _write(fd_, data_, static_cast<unsigned int>(std::min<std::size_t>(size_, 1U << 30U)));
+#else
+			ssize_t len = ::write(fd_, data_, size_);
+#endif
+			if (len < 0 && errno == EINTR)
+				continue;
+			if (len <= 0)
+				return false;
+			data_ += len;
+			size_ -= static_cast<std::size_t>(len);
+		}
+		return true;
+	}, chunk_size_)
+{
+}
+
+bool StreamWriter::write(const BigInt& val_)
+{
+	if (val_.is_neg() && !append("-", 1U))
+		return false;
+	return BigInt::write_decimal(val_, [this](const char* data_, std::size_t size_) {
+		return append(data_, size_);
+	});
+}
+
+bool StreamWriter::write(const BigReal& val_)
+{
+	return BigReal::write_text(val_, [this](const char* data_, std::size_t size_) {
+		return append(data_, size_);
+	});
+}
+
+bool StreamWriter::write(const char* data_, std::size_t size_)
+{
+	return append(data_, size_);
+}
+
+bool StreamWriter::write(const std::string& str_)
+{
+	return append(str_.data(), str_.length());
+}
+
+bool StreamWriter::flush()
+{
+	if (b_is_good && !b_buf.empty())
+		b_is_good = b_sink(b_buf.data(), b_buf.size());
+	b_buf.clear();
+	return b_is_good;
+}
+
+bool StreamWriter::is_good() const
+{
+	return b_is_good;
+}
+
+bool StreamWriter::append(const char* data_, std::size_t size_)
+{
+	while (b_is_good && size_ != 0U)
+	{
+		std::size_t len = std::min(size_, b_chunk_size - b_buf.size());
+		b_buf.insert(b_buf.end(), data_, data_ + len);
+		data_ += len;
+		size_ -= len;
+		if (b_buf.size() == b_chunk_size)
+			flush();
+	}
+	return b_is_good;
+}
+
+StreamWriter::~StreamWriter()
+{
+	flush();
+}
+
+} // end nmspc
@@ -0,0 +1,52 @@
+#pragma once
+/*
+* /File: Writer.h /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <iosfwd>
+
+
+namespace lez
+{
+	class BigInt; // forward declaration
+	class BigReal;
+
+	// decimal text in chunks of chunk_size_ bytes at most, leading digits first (divide and conquer),
+	// the full text is never in memory; after a failed sink every write is false
+	class StreamWriter
+	{
+	public:
+		using Sink = std::function<bool(const char* data_, std::size_t size_)>; // false = stop
+
+		explicit StreamWriter(Sink sink_, std::size_t chunk_size_ = 1U << 16U);
+		explicit StreamWriter(std::ostream& stream_, std::size_t chunk_size_ = 1U << 16U);
+		explicit StreamWriter(int fd_, std::size_t chunk_size_ = 1U << 16U); // file descriptor, not closed
+		StreamWriter(const StreamWriter& val_) = delete;
+
+		StreamWriter& operator=(const StreamWriter& val_) = delete;
+
+		bool write(const BigInt& val_);
+		bool write(const BigReal& val_); // same text as to_string()
+		bool write(const char* data_, std::size_t size_); // separators and such
+		bool write(const std::string& str_);
+		bool flush();
+		bool is_good() const;
+
+		~StreamWriter(); // flushes
+
+	private:
+
+		bool append(const char* data_, std::size_t size_);
+
+		Sink b_sink;
+		std::vector<char> b_buf;
+		std::size_t b_chunk_size;
+		bool b_is_good;
+	};
+}
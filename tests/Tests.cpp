@@ -0,0 +1,759 @@
+/*
+* /File: Tests.cpp /
+* /Brief: BigInt and BigReal
+* /Creator: Leonid Artemev | Leartiz /
+* /Date: 2020 /
+*/
+
+// g++ -std=c++17 -O2 -pthread -I. tests/Tests.cpp BigInt.cpp BigReal.cpp BigFloat.cpp RnsInt.cpp Binary.cpp
+//     Digits.cpp Parser.cpp Loader.cpp Writer.cpp
+// prints every failed check, the exit code is the amount of them (0 = all passed)
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include "BigInt.h"
+#include "BigReal.h"
+#include "BigFloat.h"
+#include "RnsInt.h"
+#include "Binary.h"
+#include "Parser.h"
+#include "Loader.h"
+#include "Writer.h"
+
+
+namespace
+{
+	int am_fails = 0;
+
+	void check(bool is_ok_, const char* what_, int line_)
+	{
+		if (is_ok_)
+			return;
+		++am_fails;
+		std::cout << "FAIL line " << line_ << ": " << what_ << std::endl;
+	}
+
+#define CHECK(expr_) check((expr_), #expr_, __LINE__)
+
+	using lez::BigInt;
+	using lez::BigReal;
+	using lez::BigFloat;
+	using lez::RnsInt;
+	using lez::DecimalRounding;
+	using lez::RoundingMode;
+
+	BigInt big(const std::string& str_)
+	{
+		return BigInt::to_big_int(str_);
+	}
+
+	BigReal real(const std::string& str_)
+	{
+		return BigReal::to_big_real(str_);
+	}
+
+	BigInt factorial(std::uint32_t n_)
+	{
+		BigInt res(1);
+		for (std::uint32_t i = 2U; i <= n_; ++i)
+			res *= static_cast<std::int32_t>(i);
+		return res;
+	}
+
+	std::string nines_squared(std::size_t am_) // (10^am_ - 1)^2 = 9..98 0..01
+	{
+		return std::string(am_ - 1U, '9') + "8" + std::string(am_ - 1U, '0') + "1";
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// batch remainders: product and remainder trees
+	void test_remainders()
+	{
+		BigInt val = factorial(3000U) + big("12345");
+		std::vector<BigInt> moduli = { big("1000003"), big("998244353"), big("18446744073709551557"),
+			factorial(40U) + big("1"), big("7") };
+		std::vector<BigInt> rems = BigInt::remainders(val, moduli);
+		CHECK(rems.size() == moduli.size());
+		for (std::size_t i = 0U; i < moduli.size() && i < rems.size(); ++i)
+			CHECK(rems[i] == val % moduli[i]);
+		std::vector<std::vector<BigInt>> all_rems = BigInt::remainders({ -val, big("123"), val }, moduli);
+		CHECK(all_rems.size() == 3U && all_rems[2] == rems && all_rems[1][3] == big("123"));
+		for (std::size_t i = 0U; i < moduli.size() && all_rems.size() == 3U; ++i)
+			CHECK(all_rems[0][i] == (-val) % moduli[i]);
+		CHECK(BigInt::remainders(val, {}).empty());
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// gcd and batch gcd
+	void test_gcd()
+	{
+		CHECK(BigInt::gcd(big("1071"), big("462")) == big("21"));
+		CHECK(BigInt::gcd(big("-12"), BigInt()) == big("12") && BigInt::gcd(BigInt(), BigInt()).is_zero());
+		std::vector<BigInt> gcds = BigInt::batch_gcd({ big("15"), big("77"), big("26"), big("221") });
+		CHECK(gcds.size() == 4U && gcds[0] == big("1") && gcds[1] == big("1") && gcds[2] == big("13")
+			&& gcds[3] == big("13"));
+		CHECK(BigInt::batch_gcd({ BigInt() }) == std::vector<BigInt>(1U, big("1"))); // gcd(0, empty product)
+		CHECK(BigInt::batch_gcd({ big("6"), BigInt(), big("-10") }) == std::vector<BigInt>({ big("6"), big("60"), big("10") }));
+		CHECK(BigInt::batch_gcd({ BigInt(), big("6"), BigInt() }) == std::vector<BigInt>({ BigInt(), big("6"), BigInt() }));
+		CHECK(BigInt::batch_gcd({ big("-9") }) == std::vector<BigInt>(1U, big("1")));
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// RnsInt: residues and CRT
+	void test_rns_int()
+	{
+		BigInt l_val = factorial(60U) + big("12345");
+		BigInt r_val = -(factorial(55U) - big("999"));
+		RnsInt l_rns(l_val);
+		RnsInt r_rns(r_val);
+		CHECK(l_rns.to_big_int() == l_val && r_rns.to_big_int() == r_val);
+		CHECK((l_rns * r_rns).to_big_int() == l_val * r_val);
+		CHECK((l_rns + r_rns).to_big_int() == l_val + r_val);
+		CHECK((l_rns - r_rns).to_big_int() == l_val - r_val);
+		CHECK((-l_rns).to_big_int() == -l_val);
+		CHECK(l_rns == RnsInt(l_val) && l_rns != r_rns);
+		CHECK(RnsInt(std::int64_t(-5)).to_big_int() == big("-5") && RnsInt().is_zero());
+
+		std::vector<BigInt> vals = { l_val, r_val, BigInt(), big("-1"), l_val * big("3") };
+		std::vector<RnsInt> rns = RnsInt::to_rns_int(vals);
+		CHECK(rns.size() == vals.size());
+		for (std::size_t i = 0U; i < vals.size() && i < rns.size(); ++i)
+			CHECK(rns[i] == RnsInt(vals[i]) && rns[i].to_big_int() == vals[i]);
+
+		// bases of different sizes compare by value, not by the common residues
+		std::size_t am_moduli = RnsInt::start_amount_moduli();
+		RnsInt::start_amount_moduli() = 8U;
+		BigInt prod(1);
+		for (std::size_t i = 0U; i < 8U; ++i)
+			prod *= BigInt(static_cast<std::int64_t>(RnsInt::moduli()[i]));
+		RnsInt small(std::int64_t(5));
+		RnsInt::start_amount_moduli() = am_moduli;
+		CHECK(small.amount_moduli() == 8U && small == RnsInt(std::int64_t(5)));
+		CHECK(small != RnsInt(prod + big("5")));
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// BigInt: binary limbs, shifts, bitwise operators and bit queries
+	void test_bits()
+	{
+		CHECK((BigInt(1) << 256U).to_string() ==
+			"115792089237316195423570985008687907853269984665640564039457584007913129639936");
+		CHECK(((BigInt(1) << 256U) >> 250U) == BigInt(64) && (BigInt(5) >> 3U).is_zero());
+		CHECK((big("-5") >> 1U) == big("-3") && (big("-1") >> 100U) == big("-1")); // floor, as two's complement
+		CHECK(factorial(50U).to_string() ==
+			"30414093201713378043612608166064768844377641568960512000000000000");
+		CHECK(factorial(30U) / big("1024") == big("259035995910342830699520000000"));
+		CHECK(big("-7") / big("2") == big("-3") && big("-7") % big("2") == big("-1"));
+		CHECK(big("-3") % big("5") == big("-3") && big("3") % big("-5") == big("3") && big("-3") % 5 == big("-3"));
+		CHECK(big("-5") % big("3") == big("-2") && (big("-5") % big("5")).is_zero());
+		CHECK(big("12345") / BigInt() == BigInt()); // division by zero is zero
+
+		BigInt l_val = (BigInt(1) << 100U) + big("12345");
+		BigInt r_val = -(BigInt(1) << 70U) - big("678");
+		CHECK((l_val & r_val) == big("1267650600228229401496703217688"));
+		CHECK((l_val | r_val) == big("-1180591620717411304069"));
+		CHECK((l_val ^ r_val) == big("-1267650601408821022214114521757"));
+		CHECK((big("-12") & big("10")) == BigInt() && (big("-12") | big("10")) == big("-2") && (big("-1") ^ big("5")) == big("-6"));
+		CHECK(l_val.bit_length() == 101U && l_val.popcount() == 7U && r_val.popcount() == 6U);
+		CHECK((BigInt(3) << 90U).count_trailing_zeros() == 90U && BigInt().count_trailing_zeros() == 0U);
+		CHECK(l_val.test_bit(100U) && !l_val.test_bit(99U) && r_val.test_bit(500U) && !r_val.test_bit(70U));
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// Fibonacci, Lucas and linear recurrences by fast doubling
+	void test_sequences()
+	{
+		CHECK(BigInt::fibonacci(0U).is_zero() && BigInt::fibonacci(1U) == big("1"));
+		CHECK(BigInt::fibonacci(100U) == big("354224848179261915075"));
+		CHECK(BigInt::lucas(0U) == big("2") && BigInt::lucas(100U) == big("792070839848372253127"));
+		CHECK(BigInt::fibonacci(2001U) == BigInt::fibonacci(1000U) * BigInt::fibonacci(1000U)
+			+ BigInt::fibonacci(1001U) * BigInt::fibonacci(1001U));
+		CHECK(BigInt::linear_recurrence({ big("1"), big("1") }, { BigInt(), big("1") }, 3000U) == BigInt::fibonacci(3000U));
+		CHECK(BigInt::linear_recurrence({ big("1"), big("1"), big("1") }, { BigInt(), BigInt(), big("1") }, 37U)
+			== big("1132436852")); // tribonacci
+		CHECK(BigInt::linear_recurrence({ big("2") }, { big("3") }, 10U) == big("3072"));
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// multiplication (schoolbook, Karatsuba, NTT), Newton division, divide and conquer text
+	void test_conversion()
+	{
+		// every multiplication size class against the closed form
+		for (std::size_t am : { 5U, 300U, 3000U, 40000U })
+		{
+			BigInt val = big(std::string(am, '9'));
+			CHECK((val * val).to_string() == nines_squared(am));
+			BigInt other = val - big("123456789");
+			CHECK((val * other) / other == val && (val * other) % other == BigInt());
+			CHECK(((val * val + big("777")) % val) == big("777"));
+		}
+
+		// text round trips, the long ones go through the divide and conquer conversions
+		BigInt fib = BigInt::fibonacci(100000U);
+		CHECK(big(fib.to_string()) == fib && big((-fib).to_string()) == -fib);
+		std::string digits = "1" + std::string(20000U, '0');
+		CHECK(big(digits) == big("1" + std::string(10000U, '0')) * big("1" + std::string(10000U, '0')));
+		CHECK(big("000000000000000000000000000042") == big("42"));
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// to_chars / from_chars
+	void test_chars()
+	{
+		BigInt fib = BigInt::fibonacci(20000U);
+		std::string text(fib.to_string().length() + 1U, ' ');
+		auto res_to = lez::to_chars(&text[0], &text[0] + text.length(), -fib);
+		BigInt back;
+		auto res_from = lez::from_chars(text.data(), res_to.ptr, back);
+		CHECK(res_to.ec == std::errc() && res_from.ec == std::errc() && back == -fib);
+		CHECK(lez::from_chars(text.data(), text.data(), back).ec == std::errc::invalid_argument);
+		CHECK(lez::to_chars(&text[0], &text[0] + 10, fib).ec == std::errc::value_too_large);
+
+		std::size_t am_frac = BigReal::start_amount_digits_after_comma();
+		BigReal::start_amount_digits_after_comma() = 25U;
+		for (const char* str : { "0.0", "-12.5", "3.1415926535897932384626433", "1000000.0" })
+		{
+			char buf[64];
+			auto res = lez::to_chars(buf, buf + sizeof(buf), real(str));
+			CHECK(res.ec == std::errc() && std::string(buf, res.ptr) == str);
+			CHECK(lez::to_chars(buf, buf + 2, real(str)).ec == std::errc::value_too_large);
+		}
+		BigReal::start_amount_digits_after_comma() = am_frac;
+		BigReal val;
+		const char* str = "5.e2z";
+		auto res = lez::from_chars(str, str + 5, val);
+		CHECK(res.ec == std::errc() && res.ptr == str + 4 && val == real("500")); // "5." takes the comma
+		CHECK(lez::from_chars(str + 4, str + 5, val).ec == std::errc::invalid_argument);
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// machine integers: saturating, checked and wrapping
+	void test_extractors()
+	{
+		BigInt huge = BigInt(1) << 70U;
+		CHECK(huge.to_int64() == std::numeric_limits<std::int64_t>::max());
+		CHECK((-huge).to_int64() == std::numeric_limits<std::int64_t>::min());
+		CHECK(!huge.to_uint64_checked().has_value() && huge.to_uint64_wrapping() == 0U);
+		CHECK(big("-1").to_uint64_wrapping() == std::numeric_limits<std::uint64_t>::max());
+		CHECK(big("-2147483648").to_int32_checked() == std::numeric_limits<std::int32_t>::min());
+		CHECK(!big("2147483648").fits_int32() && big("2147483648").to_int32_wrapping() == std::numeric_limits<std::int32_t>::min());
+		CHECK(real("-2.5").to_int64() == -2 && real("2.999").to_int32() == 2);
+		CHECK(real("1e30").to_int32() == std::numeric_limits<std::int32_t>::max() && !real("-1e30").fits_int64());
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// bases 2..62
+	void test_bases()
+	{
+		CHECK(big("255").to_string(16) == "ff" && big("-255").to_string(2) == "-11111111");
+		CHECK(big("61").to_string(62) == "z" && big("35").to_string(36) == "z" && big("36").to_string(62) == "a");
+		CHECK(BigInt::to_big_int("-Ff", 16) == big("-255") && BigInt::to_big_int("zz", 36) == big("1295"));
+		BigInt fib = BigInt::fibonacci(100000U); // the divide and conquer conversions
+		for (int base : { 2, 3, 7, 10, 16, 36, 62 })
+			CHECK(BigInt::to_big_int((-fib).to_string(base), base) == -fib);
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// bytes with endianness and sign
+	void test_bytes()
+	{
+		BigInt fib = BigInt::fibonacci(5000U);
+		std::vector<std::uint8_t> bytes = fib.to_bytes(lez::Endian::little);
+		CHECK(BigInt::from_bytes(bytes.data(), bytes.size(), lez::Endian::little) == fib);
+		bytes = big("258").to_bytes(lez::Endian::big);
+		CHECK(bytes == std::vector<std::uint8_t>({ 1U, 2U }));
+		bytes = big("-300").to_bytes(lez::Endian::big, lez::Signedness::twos_complement);
+		CHECK(BigInt::from_bytes(bytes.data(), bytes.size(), lez::Endian::big, lez::Signedness::twos_complement)
+			== big("-300"));
+		bytes = big("-300").to_bytes(lez::Endian::little);
+		CHECK(BigInt::from_bytes(bytes.data(), bytes.size(), lez::Endian::little) == big("300")); // |val|
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// binary format: buffer, views and streams
+	void test_binary()
+	{
+		std::vector<BigInt> ints = { BigInt(), big("-1"), big("4294967296"), -BigInt::fibonacci(5000U) };
+		std::vector<BigReal> reals = { BigReal(), real("-12.5"), real("3e-40"), real("1e1000000000000"),
+			real("-7e-9223372036854775000") };
+		lez::BinaryWriter writer;
+		for (const BigInt& val : ints)
+			writer.write(val);
+		for (const BigReal& val : reals)
+			writer.write(val);
+		std::vector<std::uint8_t> buf = writer.release();
+		lez::BinaryReader reader(buf.data(), buf.size());
+		for (const BigInt& val : ints)
+		{
+			BigInt back;
+			CHECK(reader.read(back) && back == val);
+		}
+		lez::BigRealView view;
+		CHECK(reader.read(view) && view.is_zero());
+		CHECK(reader.read(view) && view.is_neg() && view.exponent() == -1 && view.to_big_real() == real("-12.5"));
+		for (std::size_t i = 2U; i < reals.size(); ++i)
+		{
+			BigReal back;
+			CHECK(reader.read(back) && back == reals[i] && back.exponent() == reals[i].exponent());
+		}
+		CHECK(reader.is_end() && reader.position() == buf.size());
+
+		// truncated records fail and keep the position
+		lez::BinaryReader cut(buf.data(), buf.size() / 2U);
+		BigInt val;
+		std::size_t am_read = 0U;
+		while (cut.read(val))
+			++am_read;
+		CHECK(am_read < ints.size() && !cut.is_end());
+
+		std::stringstream stream;
+		lez::write_binary(stream, ints.back());
+		lez::write_binary(stream, reals[1]);
+		BigInt int_back;
+		BigReal real_back;
+		lez::read_binary(stream, int_back);
+		lez::read_binary(stream, real_back);
+		CHECK(stream && int_back == ints.back() && real_back == reals[1]);
+		lez::read_binary(stream, int_back);
+		CHECK(!stream);
+		std::stringstream huge; // a length of 2^62 limbs, more bytes than size_t counts
+		huge << static_cast<char>(lez::BinaryWriter::version << 4U) << std::string(8U, '\x80') << '\x40';
+		lez::read_binary(huge, int_back);
+		CHECK(!huge && int_back == ints.back());
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// memcmp-ordered keys
+	void test_ordered_keys()
+	{
+		BigInt fib = BigInt::fibonacci(5000U);
+		std::vector<BigInt> keys = { -fib, big("-300"), big("-1"), BigInt(), big("1"), big("300"), fib };
+		for (std::size_t i = 1U; i < keys.size(); ++i)
+			CHECK(keys[i - 1U].to_ordered_key() < keys[i].to_ordered_key());
+		std::vector<std::uint8_t> key = big("-300").to_ordered_key();
+		BigInt back;
+		CHECK(BigInt::from_ordered_key(key.data(), key.data() + key.size(), back) == key.data() + key.size()
+			&& back == big("-300"));
+		CHECK(key.size() == big("-300").ordered_key_size());
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// bulk loader: parallel chunks, long tokens
+	void test_loader()
+	{
+		std::string many;
+		std::vector<BigInt> expected;
+		for (std::uint32_t i = 0U; i < 2000U; ++i)
+		{
+			expected.push_back(BigInt::fibonacci(i * 7U) * ((i % 3U == 0U) ? -1 : 1));
+			many += expected.back().to_string() + ((i % 5U == 0U) ? "\n" : " \t ");
+		}
+		std::size_t min_chunk = lez::Loader::min_chunk_size();
+		lez::Loader::min_chunk_size() = 4096U; // several threads
+		std::vector<BigInt> ints;
+		CHECK(lez::Loader::parse_big_ints(many.data(), many.data() + many.size(), ints) && ints == expected);
+		std::vector<BigReal> reals;
+		std::string real_many = "1.5 -2e-3\n 7.25e+10 ";
+		CHECK(lez::Loader::parse_big_reals(real_many.data(), real_many.data() + real_many.size(), reals)
+			&& reals.size() == 3U && reals[1] == real("-0.002") && reals[2] == real("72500000000"));
+		BigInt long_token = BigInt::fibonacci(300000U); // one token bigger than all the chunks: split by its digits
+		std::string long_many = "5 " + long_token.to_string() + "\n-6";
+		CHECK(lez::Loader::parse_big_ints(long_many.data(), long_many.data() + long_many.size(), ints)
+			&& ints.size() == 3U && ints[1] == long_token && ints[2] == big("-6"));
+		std::string bad = many + " 12x ";
+		CHECK(!lez::Loader::parse_big_ints(bad.data(), bad.data() + bad.size(), ints) && ints.empty());
+
+		const char* path = "lez_tests_loader.txt";
+		{
+			std::ofstream file(path, std::ios::binary);
+			file << many;
+		}
+		CHECK(lez::Loader::load_big_ints(path, ints) && ints == expected);
+		std::remove(path);
+		lez::Loader::min_chunk_size() = min_chunk;
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// push parsers
+	void test_push_parsers()
+	{
+		std::string text = "  -" + BigInt::fibonacci(20000U).to_string() + " rest";
+		for (std::size_t am_chunk : { 1U, 7U, 4096U })
+		{
+			lez::BigIntParser parser;
+			std::size_t pos = 0U;
+			while (pos < text.size())
+			{
+				std::size_t len = std::min(am_chunk, text.size() - pos);
+				std::size_t am_taken = parser.feed(text.data() + pos, len);
+				pos += am_taken;
+				if (am_taken < len)
+					break;
+			}
+			BigInt val;
+			CHECK(parser.finish(val) && val == -BigInt::fibonacci(20000U) && text.compare(pos, 5U, " rest") == 0);
+		}
+
+		lez::BigRealParser parser;
+		const char* real_text = "-12.50e3x";
+		CHECK(parser.feed(real_text, 4U) == 4U && parser.feed(real_text + 4U, 5U) == 4U && parser.is_done());
+		BigReal real_val;
+		CHECK(parser.finish(real_val) && real_val == real("-12500"));
+		CHECK(parser.feed("e5", 2U) == 0U && !parser.finish(real_val)); // no digits
+		const char* far = "0.55e-9223372036854775807";
+		parser.feed(far, std::strlen(far));
+		CHECK(!parser.finish(real_val));
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// streaming writer and the cached powers of ten
+	void test_writer()
+	{
+		BigInt fib = BigInt::fibonacci(100000U);
+		std::string digits = fib.to_string();
+		{
+			std::ostringstream stream;
+			lez::StreamWriter writer(stream);
+			CHECK(writer.write(-fib) && writer.write(big("7")) && writer.flush() && stream.str() == "-" + digits + "7");
+		}
+		std::size_t am_frac = BigReal::start_amount_digits_after_comma();
+		BigReal::start_amount_digits_after_comma() = 25U;
+		for (const char* str : { "0.0", "-12.5", "3.1415926535897932384626433", "1000000.0" })
+		{
+			std::ostringstream stream;
+			lez::StreamWriter writer(stream);
+			CHECK(writer.write(real(str)) && writer.flush() && stream.str() == str);
+		}
+		BigReal::start_amount_digits_after_comma() = am_frac;
+
+		// the same digits with the powers of ten past a small limit made on demand, then from a clean cache
+		BigInt::power_cache_limbs() = 64U;
+		BigInt::clear_caches();
+		CHECK(fib.to_string() == digits && big(digits) == fib);
+		BigInt::power_cache_limbs() = 1U << 20U;
+		BigInt::clear_caches();
+		CHECK(fib.to_string() == digits && big(digits) == fib);
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// digit kernels: every length around the vector widths, a bad byte at every position
+	void test_digit_kernels()
+	{
+		std::string digits = "1";
+		for (std::size_t len = 1U; len <= 100U; ++len, digits += static_cast<char>('0' + len * 7U % 10U))
+		{
+			BigInt val = big(digits);
+			CHECK(val.to_string() == digits && (-val).to_string() == "-" + digits);
+			std::string bad = digits;
+			bad[len / 2U] = ':'; // just after '9'
+			BigInt back;
+			auto res = lez::from_chars(bad.data(), bad.data() + bad.size(), back);
+			CHECK((len / 2U == 0U) ? res.ec == std::errc::invalid_argument
+				: res.ec == std::errc() && res.ptr == bad.data() + len / 2U);
+		}
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// double and float: exact in, correctly rounded out
+	void test_doubles()
+	{
+		CHECK(real("0.1").to_double() == 0.1 && real("1e-320").to_double() == 1e-320);
+		CHECK(BigReal(0.1) == real("0.1000000000000000055511151231257827021181583404541015625"));
+		CHECK(real("0.1").to_float() == 0.1f && BigReal(0.5f) == real("0.5"));
+		CHECK(real("1e400").to_double() == std::numeric_limits<double>::infinity());
+		CHECK(real("9007199254740993").to_double() == 9007199254740992.0); // a tie, to even
+		CHECK(BigReal(std::numeric_limits<double>::quiet_NaN()).is_zero());
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// scientific notation, exponents far beyond any memory decided from the magnitude
+	void test_scientific()
+	{
+		CHECK(real("-1.2345e-7").to_string_scientific(3U) == "-1.23e-7");
+		CHECK(real("12345").to_string_scientific(2U) == "1.2e4" && real("0").to_string_scientific(2U) == "0.0e0");
+		BigReal huge = real("1e1000000000000");
+		CHECK(huge.to_int64() == std::numeric_limits<std::int64_t>::max() && !huge.fits_uint64());
+		CHECK((-huge).to_uint64() == 0U && !huge.to_int32_checked().has_value() && huge.to_int64_wrapping() == 0);
+		CHECK(real("1.5e21").to_int64_wrapping() == big("1500000000000000000000").to_int64_wrapping());
+		CHECK(huge > real("1e999999999999") && -huge < real("-1e999999999999") && huge != huge + real("1"));
+		CHECK(real("1e-1000000000000") < real("1e-999999999999") && real("1e-1000000000000") > BigReal());
+		CHECK(huge + real("1") > huge && huge - real("1") < huge && (huge - real("1")).exponent() > 999999999000);
+		CHECK(huge.to_string() == "1e1000000000000" && real(huge.to_string()) == huge);
+		CHECK(huge.to_double() == std::numeric_limits<double>::infinity() && (-huge).to_double() < 0.0);
+		CHECK(real("1e-1000000000000").to_double() == 0.0);
+		CHECK(real("9e9223372036854775807") > huge);
+		BigReal val(7);
+		const char* text = "0.55e-9223372036854775807";
+		CHECK(lez::from_chars(text, text + std::strlen(text), val).ec == std::errc::result_out_of_range && val == BigReal(7));
+		text = "1e9223372036854775808";
+		CHECK(lez::from_chars(text, text + std::strlen(text), val).ec == std::errc::result_out_of_range);
+		std::ostringstream stream;
+		lez::StreamWriter writer(stream);
+		CHECK(writer.write(-huge) && writer.flush() && stream.str() == "-1e1000000000000");
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// cached decimal digits
+	void test_decimal_cache()
+	{
+		std::size_t min_cached_limbs = BigInt::decimal_cache_limbs();
+		BigInt::decimal_cache_limbs() = 8U;
+		BigInt val = BigInt::fibonacci(20000U);
+		std::string digits = val.to_string();
+		CHECK(val.to_string() == digits && (-val).to_string() == "-" + digits);
+		BigInt cp(val); // shares the digits, its own changes drop them
+		BigInt other(val);
+		BigInt moved(std::move(other));
+		CHECK(cp.to_string() == digits && moved.to_string() == digits);
+		CHECK(BigReal::to_big_real(cp, -3).to_string() == digits.substr(0U, digits.length() - 3U) + "."
+			+ digits.substr(digits.length() - 3U));
+		cp *= BigInt(10);
+		CHECK(cp.to_string() == digits + "0" && val.to_string() == digits);
+		val += BigInt(1); // a change drops the digits
+		CHECK(val.to_string() != digits && big(val.to_string()) == val && moved.to_string() == digits);
+		BigInt::decimal_cache_limbs() = min_cached_limbs;
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// BigReal: coefficient * 10^exponent
+	void test_big_real()
+	{
+		CHECK(real("0.1") + real("0.2") == real("0.3"));
+		CHECK(real("1.5") * real("2.25") == real("3.375"));
+		CHECK(real("1") - real("0.001") == real("0.999"));
+		CHECK(real("-0.5") * real("0.5") == real("-0.25") && (real("3") - real("3")).is_zero());
+		CHECK(real("12.5") > real("12.49") && real("-1e-30") < BigReal() && real("100") == real("1e2"));
+		CHECK(BigReal::to_big_real(big("125"), -2) == real("1.25") && real("1.25").exponent() == -2);
+		CHECK(real("1.5e3").exponent() == 2 && real("1.5e3") == real("1500")); // the exponent is kept
+		CHECK(real("0.5") * BigReal(4) == BigReal(2) && real("7.25") - real("0.25") == BigReal(7));
+		CHECK((real("5e9223372036854775000") * real("5e9223372036854775000")).is_zero()); // beyond int64
+
+		std::size_t am_frac = BigReal::start_amount_digits_after_comma();
+		BigReal::start_amount_digits_after_comma() = 25U;
+		for (const char* str : { "0.0", "-12.5", "3.1415926535897932384626433", "1000000.0" })
+			CHECK(real(str).to_string() == str);
+		BigReal::start_amount_digits_after_comma() = am_frac;
+
+		// long fractions go out a piece at a time: the point counted into the digits, trailing zeros dropped
+		std::string digits = BigInt::fibonacci(100000U).to_string();
+		for (std::int64_t exp : { -30000, -10000 })
+		{
+			BigReal val = BigReal::to_big_real(big(digits + "000"), exp);
+			val.set_amount_digits_after_comma(40000U);
+			std::size_t am_frac_digs = static_cast<std::size_t>(-exp) - 3U;
+			std::string text = (am_frac_digs >= digits.length())
+				? "0." + std::string(am_frac_digs - digits.length(), '0') + digits
+				: digits.substr(0U, digits.length() - am_frac_digs) + "." + digits.substr(digits.length() - am_frac_digs);
+			std::ostringstream stream;
+			lez::StreamWriter writer(stream);
+			CHECK(val.to_string() == text && writer.write(val) && writer.flush() && stream.str() == text);
+		}
+		BigReal cut = real("-0.1005"); // truncated as if rounded: no zeros kept at the cut, no sign on zero
+		cut.set_amount_digits_after_comma(2U);
+		CHECK(cut.to_string() == "-0.1");
+		cut.set_amount_digits_after_comma(0U);
+		CHECK(cut.to_string() == "0");
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// BigFloat: binary, correctly rounded
+	void test_big_float()
+	{
+		BigFloat one = BigFloat::to_big_float(BigInt(1), 53U, RoundingMode::nearest_even);
+		BigFloat three = BigFloat::to_big_float(BigInt(3), 53U, RoundingMode::nearest_even);
+		CHECK(BigFloat::divide(one, three, 53U, RoundingMode::nearest_even).to_double() == 1.0 / 3.0);
+		CHECK(BigFloat::to_big_float(0.1, 53U, RoundingMode::nearest_even).to_double() == 0.1);
+		CHECK(BigFloat::to_big_float(real("0.1"), 53U, RoundingMode::nearest_even).to_double() == 0.1);
+		CHECK(BigFloat::to_big_float(0.5, 53U, RoundingMode::nearest_even).to_big_real() == real("0.5"));
+
+		// ties at 53 bits: 1 + 2^-53 to even, 1 + 3 * 2^-53 away to even
+		BigFloat half_ulp = BigFloat::to_big_float(std::ldexp(1.0, -53), 53U, RoundingMode::nearest_even);
+		CHECK(BigFloat::add(one, half_ulp, 53U, RoundingMode::nearest_even).to_double() == 1.0);
+		BigFloat next = BigFloat::to_big_float(1.0 + std::ldexp(1.0, -52), 53U, RoundingMode::nearest_even);
+		CHECK(BigFloat::add(next, half_ulp, 53U, RoundingMode::nearest_even).to_double() == 1.0 + std::ldexp(1.0, -51));
+		BigFloat tiny = BigFloat::to_big_float(std::ldexp(1.0, -60), 53U, RoundingMode::nearest_even);
+		CHECK(BigFloat::add(one, tiny, 53U, RoundingMode::up).to_double() == 1.0 + std::ldexp(1.0, -52));
+		CHECK(BigFloat::add(one, tiny, 53U, RoundingMode::down).to_double() == 1.0);
+		CHECK(BigFloat::subtract(one, tiny, 53U, RoundingMode::toward_zero).to_double() == 1.0 - std::ldexp(1.0, -53));
+		CHECK(BigFloat::multiply(three, three, 2U, RoundingMode::nearest_even).to_big_int() == big("8"));
+		CHECK(BigFloat::divide(one, BigFloat(), 53U, RoundingMode::nearest_even).is_zero());
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// rounding of ties in every mode
+	void test_rounding()
+	{
+		struct Tie { const char* val; DecimalRounding mode; const char* res; };
+		const Tie ties[] = {
+			{ "0.125", DecimalRounding::half_even, "0.12" }, { "0.135", DecimalRounding::half_even, "0.14" },
+			{ "0.125", DecimalRounding::half_up, "0.13" }, { "0.125", DecimalRounding::floor, "0.12" },
+			{ "0.125", DecimalRounding::ceil, "0.13" }, { "0.125", DecimalRounding::truncate, "0.12" },
+			{ "-0.125", DecimalRounding::half_even, "-0.12" }, { "-0.125", DecimalRounding::half_up, "-0.13" },
+			{ "-0.125", DecimalRounding::floor, "-0.13" }, { "-0.125", DecimalRounding::ceil, "-0.12" },
+			{ "-0.125", DecimalRounding::truncate, "-0.12" }, { "2.5", DecimalRounding::half_even, "2" },
+			{ "3.5", DecimalRounding::half_even, "4" }, { "0.1250000000000000000001", DecimalRounding::half_even, "0.13" },
+		};
+		for (const Tie& tie : ties)
+		{
+			std::size_t am_frac = (std::strchr(tie.res, '.') == nullptr) ? 0U
+				: std::strlen(std::strchr(tie.res, '.')) - 1U;
+			CHECK(real(tie.val).rounded(am_frac, tie.mode) == real(tie.res));
+			CHECK(BigReal::divide(real(tie.val) * real("8"), real("8"), am_frac, tie.mode) == real(tie.res));
+		}
+
+		// the text rounds with start_rounding(), guard_digits() bounds + - *
+		BigReal::start_rounding() = DecimalRounding::half_even;
+		BigReal val = real("0.125");
+		val.set_amount_digits_after_comma(2U);
+		CHECK(val.to_string() == "0.12");
+		val = real("0.135");
+		val.set_amount_digits_after_comma(2U);
+		CHECK(val.to_string() == "0.14");
+		BigReal::guard_digits() = 1U;
+		BigReal l_val = real("1.25");
+		BigReal r_val = real("1.01");
+		l_val.set_amount_digits_after_comma(1U);
+		r_val.set_amount_digits_after_comma(1U);
+		CHECK((l_val * r_val) == real("1.26")); // 1.2625 to 2 digits
+		r_val = real("0.005");
+		r_val.set_amount_digits_after_comma(1U);
+		CHECK((l_val + r_val) == real("1.26")); // 1.255, tie to even
+		BigReal::guard_digits() = std::string::npos;
+		BigReal::start_rounding() = DecimalRounding::truncate;
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// short products: only the kept digits of a long product
+	void test_short_products()
+	{
+		BigReal l_val = BigReal::divide(real("1"), real("3"), 3000U, DecimalRounding::truncate);
+		BigReal r_val = BigReal::divide(real("-2"), real("7"), 3000U, DecimalRounding::truncate);
+		BigReal exact = l_val * r_val;
+		BigReal::start_rounding() = DecimalRounding::half_even;
+		BigReal::guard_digits() = 2U;
+		l_val.set_amount_digits_after_comma(20U);
+		r_val.set_amount_digits_after_comma(20U);
+		CHECK(l_val * r_val == exact.rounded(22U, DecimalRounding::half_even));
+		BigReal::start_rounding() = DecimalRounding::ceil;
+		CHECK(l_val * r_val == exact.rounded(22U, DecimalRounding::ceil));
+		BigReal::guard_digits() = std::string::npos;
+		BigReal::start_rounding() = DecimalRounding::truncate;
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// division correctly rounded, Newton reciprocal for long operands
+	void test_division()
+	{
+		CHECK(BigReal::divide(real("2"), real("3"), 10U, DecimalRounding::half_even) == real("0.6666666667"));
+		CHECK(BigReal::divide(real("-2"), real("3"), 10U, DecimalRounding::floor) == real("-0.6666666667"));
+		CHECK(BigReal::divide(real("1"), BigReal(), 10U, DecimalRounding::half_even).is_zero());
+		BigReal third = BigReal::divide(real("1"), real("3"), 5000U, DecimalRounding::truncate); // Newton
+		CHECK(third.to_string_scientific(5000U) == "3." + std::string(4999U, '3') + "e-1");
+		BigReal long_den = BigReal::divide(real("1"), real("7"), 4000U, DecimalRounding::truncate);
+		CHECK(BigReal::divide(real("1"), long_den, 2U, DecimalRounding::ceil) == real("7.01"));
+	}
+
+
+	// ----------------------------------------------------------------------------
+	// roots correctly rounded
+	void test_roots()
+	{
+		CHECK(BigReal::sqrt(real("2"), 30U, DecimalRounding::half_even).to_string()
+			== "1.41421356237309504880168872421"); // trailing zeros are not written
+		CHECK(BigReal::sqrt(real("2"), 30U, DecimalRounding::truncate).to_string()
+			== "1.414213562373095048801688724209");
+		CHECK(BigReal::rsqrt(real("2"), 30U, DecimalRounding::half_even).to_string()
+			== "0.707106781186547524400844362105");
+		CHECK(BigReal::rsqrt(real("0.25"), 0U, DecimalRounding::ceil) == real("2")); // exact, nothing dropped
+		CHECK(BigReal::rsqrt(real("4"), 0U, DecimalRounding::half_even).is_zero()); // a tie
+		CHECK(BigReal::rsqrt(real("4"), 0U, DecimalRounding::half_up) == real("1"));
+		CHECK(BigReal::rsqrt(real("1e-40"), 3U, DecimalRounding::truncate) == real("1e20"));
+		CHECK(BigReal::rsqrt(real("1e41"), 30U, DecimalRounding::floor) == real("3.16227766e-21"));
+		BigReal root_two = BigReal::sqrt(real("2"), 3000U, DecimalRounding::truncate);
+		CHECK(BigReal::rsqrt(real("2"), 3000U, DecimalRounding::truncate)
+			== BigReal::divide(root_two, real("2"), 3000U, DecimalRounding::truncate)); // 1 / sqrt(2) = sqrt(2) / 2
+		CHECK(BigReal::cbrt(real("10"), 20U, DecimalRounding::half_even).to_string() == "2.15443469003188372176");
+		CHECK(BigReal::cbrt(real("-27e-3"), 5U, DecimalRounding::truncate) == real("-0.3"));
+		CHECK(BigReal::root(real("32"), 5U, 10U, DecimalRounding::ceil) == real("2"));
+		CHECK(BigReal::sqrt(real("-4"), 5U, DecimalRounding::half_even).is_zero()); // even roots of negatives
+
+		// long roots next to an integer: settled by the powers, not by the estimate
+		std::string digits = BigInt::fibonacci(3000U).to_string();
+		BigReal base = real(digits);
+		for (std::uint32_t n : { 2U, 3U, 7U })
+		{
+			BigReal pow = base;
+			for (std::uint32_t i = 1U; i < n; ++i)
+				pow = pow * base;
+			CHECK(BigReal::root(pow, n, 0U, DecimalRounding::ceil) == base);
+			CHECK(BigReal::root(pow - BigReal(1), n, 0U, DecimalRounding::floor) == base - BigReal(1));
+			CHECK(BigReal::root(pow - BigReal(1), n, 0U, DecimalRounding::ceil) == base);
+			CHECK(BigReal::root(pow + BigReal(1), n, 0U, DecimalRounding::floor) == base);
+		}
+	}
+}
+
+
+int main()
+{
+	test_remainders();
+	test_gcd();
+	test_rns_int();
+	test_bits();
+	test_sequences();
+	test_conversion();
+	test_chars();
+	test_extractors();
+	test_bases();
+	test_bytes();
+	test_binary();
+	test_ordered_keys();
+	test_loader();
+	test_push_parsers();
+	test_writer();
+	test_digit_kernels();
+	test_doubles();
+	test_scientific();
+	test_decimal_cache();
+	test_big_real();
+	test_big_float();
+	test_rounding();
+	test_short_products();
+	test_division();
+	test_roots();
+	std::cout << (am_fails == 0 ? "all passed" : "failed: ") << (am_fails == 0 ? "" : std::to_string(am_fails))
+		<< std::endl;
+	return am_fails;
+}